@@ -34,12 +34,13 @@ int main()
         cout << "Ключ загружен." << endl;
 
         do {
-            cout << "Выберите режим (0-выход, 1-шифрование, 2-расшифровка): ";
+            cout << "Выберите режим (0-выход, 1-шифрование, 2-расшифровка, "
+                 << "3-шифрование с сохранением формата, 4-расшифровка с сохранением формата): ";
             if (!(cin >> action))
                 return 0;
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-            if (action > 2) {
+            if (action > 4) {
                 cout << "Неверный выбор режима." << endl;
             } else if (action > 0) {
                 cout << "Введите строку: ";
@@ -49,9 +50,15 @@ int main()
                     if (action == 1) {
                         wstring enc = cipher.encrypt(str8_to_w(msgLine));
                         cout << "Зашифровано: " << w_to_str8(enc) << endl;
-                    } else {
+                    } else if (action == 2) {
                         wstring dec = cipher.decrypt(str8_to_w(msgLine));
                         cout << "Расшифровано: " << w_to_str8(dec) << endl;
+                    } else if (action == 3) {
+                        string enc = cipher.encryptPreserving(msgLine);
+                        cout << "Зашифровано: " << enc << endl;
+                    } else {
+                        string dec = cipher.decryptPreserving(msgLine);
+                        cout << "Расшифровано: " << dec << endl;
                     }
                 } catch (const cipher_error& e) {
                     cerr << "Ошибка: " << e.what() << endl;
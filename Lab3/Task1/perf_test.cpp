@@ -0,0 +1,94 @@
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <vector>
+#include "modAlphaCipher.h"
+#include "../perf.h"
+using namespace std;
+
+const size_t LETTERS = 1 << 20;
+
+SUITE(ThroughputTest)
+{
+    TEST(EncryptMixedText) {
+        wstring text = perf::corpus(LETTERS, true);
+        modAlphaCipher cp(L"ГРОМ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.encrypt(text); });
+        CHECK(perf::baseline().accept("gronsfeld.encrypt", r));
+    }
+
+    TEST(DecryptCipherText) {
+        wstring text = perf::corpus(LETTERS, false);
+        modAlphaCipher cp(L"ГРОМ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decrypt(text); });
+        CHECK(perf::baseline().accept("gronsfeld.decrypt", r));
+    }
+
+    TEST(LongKey) {
+        wstring text = perf::corpus(LETTERS, false);
+        modAlphaCipher cp(L"ЗИМНИЙВЕЧЕРВЕЗДЕТЬМАБРАТОЯКАКДЕЛА");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.encrypt(text); });
+        CHECK(perf::baseline().accept("gronsfeld.encrypt_long_key", r));
+    }
+
+    TEST(DecryptPacked) {
+        // пропускная способность в тех же единицах, что и для wchar_t: буквы * sizeof(wchar_t)
+        wstring text = perf::corpus(LETTERS, false);
+        PackedText packed = PackedText::fromText(text);
+        modAlphaCipher cp(L"ГРОМ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decrypt(packed); });
+        CHECK(perf::baseline().accept("gronsfeld.decrypt_packed", r));
+    }
+
+    TEST(FanOut) {
+        // пропускная способность по суммарному объёму: текст * число ключей, как у encrypt по одному ключу
+        wstring text = perf::corpus(LETTERS, true);
+        vector<modAlphaCipher> ciphers;
+        for (auto key : {L"ГРОМ", L"ЗИМНИЙ", L"ВЕЧЕР", L"БРАТ", L"КЛЮЧ", L"ПРИВЕТ", L"МИР", L"ДЕЛА"})
+            ciphers.emplace_back(key);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t) * ciphers.size(),
+                                       [&] { modAlphaCipher::encryptMany(ciphers, text); });
+        CHECK(perf::baseline().accept("gronsfeld.encrypt_fanout8", r));
+    }
+
+    TEST(EncryptPreserving) {
+        // пропускная способность в тех же единицах, что и для wchar_t: символы * sizeof(wchar_t)
+        wstring text = perf::corpus(LETTERS, true);
+        string utf8;
+        for (auto c : text) {
+            int idx = rus::letterIndex(c);
+            if (idx < 0) {
+                utf8.push_back(static_cast<char>(c));
+            } else if (rus::upperIndex(c) >= 0) {
+                utf8.push_back(rus::utf8Lead(idx));
+                utf8.push_back(rus::utf8Trail(idx));
+            } else {
+                utf8.push_back(rus::utf8LowerLead(idx));
+                utf8.push_back(rus::utf8LowerTrail(idx));
+            }
+        }
+        modAlphaCipher cp(L"ГРОМ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.encryptPreserving(utf8); });
+        CHECK(perf::baseline().accept("gronsfeld.encrypt_preserving", r));
+    }
+
+    TEST(TryDecryptInvalid) {
+        // путь ошибки: недопустимый символ в конце текста, память не выделяется
+        wstring text = perf::corpus(LETTERS, false) + L"?";
+        modAlphaCipher cp(L"ГРОМ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.tryDecrypt(text); });
+        CHECK_EQUAL(0u, r.allocations);
+        CHECK(perf::baseline().accept("gronsfeld.try_decrypt_invalid", r));
+    }
+
+    TEST(Rekey) {
+        wstring text = perf::corpus(LETTERS, false);
+        modAlphaCipher from(L"ГРОМ"), to(L"ЗИМНИЙ");
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { modAlphaCipher::rekey(from, to, text); });
+        CHECK(perf::baseline().accept("gronsfeld.rekey", r));
+    }
+}
+
+int main()
+{
+    return UnitTest::RunAllTests();
+}
@@ -2,7 +2,16 @@
 #include <string>
 #include <locale>
 #include <codecvt>
+#include <vector>
+#include <thread>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
 #include "modAlphaCipher.h"
+#include "countingResource.h"
+#include "keyCache.h"
+#include "fixedCipher.h"
+#include "cipherContainer.h"
 using namespace std;
 
 string wideToUtf8(const wstring& ws) {
@@ -116,6 +125,368 @@ SUITE(DecryptTest)
     }
 }
 
+SUITE(AllocatorTest)
+{
+    TEST(ArenaMatchesDefault) {
+        std::pmr::monotonic_buffer_resource arena;
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK_WIDE_EQUAL(cp.encrypt(L"Привет, мир!"), wstring(cp.encrypt(L"Привет, мир!", &arena)));
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", wstring(cp.decrypt(cp.encrypt(L"Привет, мир!", &arena), &arena)));
+    }
+
+    TEST(ArenaErrors) {
+        std::pmr::monotonic_buffer_resource arena;
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK_THROW(cp.encrypt(L"123", &arena), cipher_error);
+        CHECK_THROW(cp.decrypt(L"Привет", &arena), cipher_error);
+    }
+
+    TEST(NoSteadyStateAllocations) {
+        static std::byte buf[1 << 14];
+        CountingResource counter;
+        std::pmr::monotonic_buffer_resource arena(buf, sizeof buf, &counter);
+        modAlphaCipher cp(L"ГРОМ");
+        for (int request = 0; request < 100; ++request) {
+            std::pmr::wstring c = cp.encrypt(L"Съешь же ещё этих мягких французских булок", &arena);
+            CHECK_WIDE_EQUAL(L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК", wstring(cp.decrypt(c, &arena)));
+            arena.release();
+        }
+        CHECK_EQUAL(0u, counter.allocations());
+    }
+}
+
+SUITE(SharedInstanceTest)
+{
+    TEST(ConstInstanceAcrossThreads) {
+        const modAlphaCipher cp(L"ГРОМ");
+        const wstring expected = cp.encrypt(L"Съешь же ещё этих мягких французских булок");
+        vector<int> mismatches(4, 0);
+        vector<thread> pool;
+        for (int t = 0; t < 4; ++t) {
+            pool.emplace_back([&, t] {
+                for (int i = 0; i < 1000; ++i) {
+                    wstring c = cp.encrypt(L"Съешь же ещё этих мягких французских булок");
+                    if (c != expected || cp.decrypt(c) != L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК")
+                        mismatches[t]++;
+                }
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+        for (int t = 0; t < 4; ++t)
+            CHECK_EQUAL(0, mismatches[t]);
+    }
+
+    TEST(UnknownSymbolsLeaveInstanceUsable) {
+        const modAlphaCipher cp(L"Б");
+        CHECK_THROW(cp.decrypt(L"AБВ"), cipher_error);
+        CHECK_WIDE_EQUAL(L"ВГД", cp.encrypt(L"бвг"));
+    }
+}
+
+SUITE(KeyCacheTest)
+{
+    TEST(SameInstanceForNormalizedKey) {
+        KeyCache cache;
+        auto a = cache.get(L"гром");
+        auto b = cache.get(L"ГрОм");
+        CHECK(a == b);
+        CHECK_EQUAL(1u, cache.size());
+        CHECK_EQUAL(1u, cache.misses());
+        CHECK_EQUAL(1u, cache.hits());
+        CHECK_WIDE_EQUAL(modAlphaCipher(L"ГРОМ").encrypt(L"ПРИВЕТ"), a->encrypt(L"ПРИВЕТ"));
+    }
+
+    TEST(InvalidKeysThrowAndAreNotCached) {
+        KeyCache cache;
+        CHECK_THROW(cache.get(L""), cipher_error);
+        CHECK_THROW(cache.get(L"Б1"), cipher_error);
+        CHECK_THROW(cache.get(L"ААБ"), cipher_error);
+        CHECK_EQUAL(0u, cache.size());
+    }
+
+    TEST(BoundedSize) {
+        KeyCache cache(KeyCache::SHARDS);
+        for (int i = 0; i < 200; ++i) {
+            wstring key = {modAlphaCipher::alphabet[1 + i % 32], modAlphaCipher::alphabet[i / 32]};
+            cache.get(key);
+        }
+        CHECK(cache.size() <= KeyCache::SHARDS);
+        auto evicted = cache.get(L"БА");
+        CHECK_WIDE_EQUAL(L"БА", evicted->encrypt(L"АА"));
+    }
+
+    TEST(CapacityRoundedUpPerShard) {
+        CHECK_THROW(KeyCache(0), cipher_error);
+        CHECK_THROW(KeyCache(KeyCache::SHARDS - 1), cipher_error);
+        KeyCache cache(KeyCache::SHARDS + 1);
+        for (int i = 0; i < 1024; ++i) {
+            wstring key = {modAlphaCipher::alphabet[1 + i % 32], modAlphaCipher::alphabet[i / 32]};
+            cache.get(key);
+        }
+        CHECK(cache.size() > KeyCache::SHARDS);
+        CHECK(cache.size() <= 2 * KeyCache::SHARDS);
+    }
+
+    TEST(HotKeySurvivesEviction) {
+        KeyCache cache(4 * KeyCache::SHARDS);
+        auto hot = cache.get(L"ГРОМ");
+        for (int i = 0; i < 500; ++i) {
+            wstring key = {modAlphaCipher::alphabet[1 + i % 32], modAlphaCipher::alphabet[i / 32 % 32]};
+            cache.get(key);
+            CHECK(cache.get(L"ГРОМ") == hot);
+        }
+        CHECK(cache.size() <= 4 * KeyCache::SHARDS);
+    }
+
+    TEST(ConcurrentGetsShareInstance) {
+        KeyCache cache;
+        vector<shared_ptr<const modAlphaCipher>> got(4);
+        vector<thread> pool;
+        for (int t = 0; t < 4; ++t) {
+            pool.emplace_back([&, t] {
+                for (int i = 0; i < 1000; ++i)
+                    got[t] = cache.get(i % 2 ? L"ключ" : L"КЛЮЧ");
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+        for (int t = 1; t < 4; ++t)
+            CHECK(got[0] == got[t]);
+        CHECK_EQUAL(1u, cache.size());
+    }
+}
+
+static_assert(FixedGronsfeld<L'Б', L'В', L'Г'>::encrypt(L"ааааа").view() == L"БВГБВ",
+              "шифрование литерала при компиляции");
+static_assert(FixedGronsfeld<L'Г', L'Р', L'О', L'М'>::decrypt(L"ТБЧОЗГ").view() == L"ПРИВЕТ",
+              "расшифровывание литерала при компиляции");
+
+SUITE(FixedKeyTest)
+{
+    TEST(MatchesRuntimeCipher) {
+        const wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю";
+        using Key = FixedGronsfeld<L'г', L'Р', L'О', L'М'>;
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK_WIDE_EQUAL(cp.encrypt(text), Key::encrypt(text));
+        CHECK_WIDE_EQUAL(cp.decrypt(cp.encrypt(text)), Key::decrypt(cp.encrypt(text)));
+        CHECK_WIDE_EQUAL(cp.encrypt(text), Key::encrypt(L"Съешь же ещё этих мягких французских булок, да выпей чаю").str());
+    }
+
+    TEST(Errors) {
+        using Key = FixedGronsfeld<L'Б'>;
+        CHECK_THROW(Key::encrypt(wstring(L"123")), cipher_error);
+        CHECK_THROW(Key::decrypt(wstring(L"ПРИ ВЕТ")), cipher_error);
+        CHECK_THROW(Key::decrypt(wstring()), cipher_error);
+        CHECK_THROW(Key::encrypt(L"!!!"), cipher_error);
+    }
+}
+
+SUITE(PackedTest)
+{
+    TEST(RoundTrip) {
+        const wstring text = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОКЯЯ";
+        for (size_t n = 0; n <= text.size(); ++n) {
+            PackedText p = PackedText::fromText(text.substr(0, n));
+            CHECK_EQUAL(n, p.size());
+            CHECK_EQUAL((n + 2) / 3, p.data().size());
+            CHECK_WIDE_EQUAL(text.substr(0, n), p.toText());
+            if (n > 0)
+                CHECK_EQUAL(rus::upperIndex(text[n - 1]), p.at(n - 1));
+        }
+    }
+
+    TEST(InvalidInput) {
+        CHECK_THROW(PackedText::fromText(L"ПРИВЕТ МИР"), cipher_error);
+        CHECK_THROW(PackedText::fromText(L"привет"), cipher_error);
+        CHECK_THROW(PackedText::fromData({1, 2}, 7), cipher_error);
+        CHECK_THROW(PackedText::fromData({PackedText::WORD_LIMIT}, 3), cipher_error);
+        CHECK_THROW(PackedText::fromData({PackedText::word(1, 2, 3)}, 2), cipher_error);
+        CHECK_WIDE_EQUAL(L"БВ", PackedText::fromData({PackedText::word(1, 2, 0)}, 2).toText());
+    }
+
+    TEST(CipherOnPackedBlocks) {
+        modAlphaCipher cp(L"ГРОМ");
+        const wstring text = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК";
+        for (size_t n = 1; n <= text.size(); ++n) {
+            wstring part = text.substr(0, n);
+            PackedText c = cp.encrypt(PackedText::fromText(part));
+            CHECK(PackedText::fromText(cp.encrypt(part)) == c);
+            CHECK(PackedText::fromText(part) == cp.decrypt(c));
+        }
+        CHECK_THROW(cp.encrypt(PackedText()), cipher_error);
+        CHECK_THROW(cp.decrypt(PackedText()), cipher_error);
+    }
+}
+
+SUITE(PreservingTest)
+{
+    TEST(KeepsCaseAndPunctuation) {
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK_EQUAL(wideToUtf8(L"Тбчозг, ыху!"), cp.encryptPreserving(wideToUtf8(L"Привет, мир!")));
+        CHECK_EQUAL(wideToUtf8(L"Привет, мир!"), cp.decryptPreserving(wideToUtf8(L"Тбчозг, ыху!")));
+    }
+
+    TEST(LettersMatchEncrypt) {
+        const wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю. Ёлка — 2025 год \x263a Ω";
+        modAlphaCipher cp(L"ЗИМНИЙ");
+        string enc = cp.encryptPreserving(wideToUtf8(text));
+        CHECK_EQUAL(wideToUtf8(text).size(), enc.size());
+        wstring_convert<codecvt_utf8<wchar_t>> conv;
+        wstring letters;
+        for (auto c : conv.from_bytes(enc)) {
+            if (rus::letterIndex(c) >= 0)
+                letters.push_back(rus::UPPER[rus::letterIndex(c)]);
+        }
+        CHECK_WIDE_EQUAL(cp.encrypt(text), letters);
+        CHECK_EQUAL(wideToUtf8(text), cp.decryptPreserving(enc));
+    }
+
+    TEST(InvalidSequencesAreCopied) {
+        modAlphaCipher cp(L"Б");
+        CHECK_EQUAL(string("\xd0\x91\xd0" "A\xff\xd0\xb1"), cp.encryptPreserving("\xd0\x90\xd0" "A\xff\xd0\xb0"));
+    }
+
+    TEST(NoLetters) {
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK_THROW(cp.encryptPreserving("2025, hello!"), cipher_error);
+        CHECK_THROW(cp.decryptPreserving(""), cipher_error);
+    }
+}
+
+SUITE(TryTest)
+{
+    TEST(Success) {
+        auto cp = modAlphaCipher::tryCreate(L"ГРОМ");
+        CHECK(cp.ok());
+        auto r = cp.value().tryEncrypt(L"Привет!");
+        CHECK(r.ok());
+        CHECK(r.error().code == CipherErrc::Ok);
+        CHECK_WIDE_EQUAL(L"ТБЧОЗГ", r.value());
+        CHECK_WIDE_EQUAL(L"ПРИВЕТ", cp.value().tryDecrypt(L"ТБЧОЗГ").value());
+    }
+
+    TEST(ErrorCodesAndPositions) {
+        CHECK(modAlphaCipher::tryCreate(L"").error().code == CipherErrc::EmptyKey);
+        auto badKey = modAlphaCipher::tryCreate(L"ГР1М");
+        CHECK(badKey.error().code == CipherErrc::InvalidKey);
+        CHECK_EQUAL(2u, badKey.error().position);
+        CHECK(modAlphaCipher::tryCreate(L"ААБ").error().code == CipherErrc::DegenerateKey);
+
+        modAlphaCipher cp(L"ГРОМ");
+        CHECK(cp.tryEncrypt(L"2025, hello!").error().code == CipherErrc::EmptyOpenText);
+        CHECK(cp.tryDecrypt(L"").error().code == CipherErrc::EmptyCipherText);
+        auto bad = cp.tryDecrypt(L"ТБЧ ОЗГ");
+        CHECK(!bad);
+        CHECK(bad.error().code == CipherErrc::InvalidCipherText);
+        CHECK_EQUAL(3u, bad.error().position);
+        CHECK_EQUAL(string("Недопустимый шифротекст"), bad.error().message());
+        CHECK_THROW(bad.value(), cipher_error);
+    }
+}
+
+SUITE(FanOutTest)
+{
+    TEST(MatchesSingleKeyEncrypt) {
+        wstring text;
+        for (int i = 0; i < 300; ++i)
+            text += L"Съешь же ещё этих мягких французских булок, да выпей чаю. ";
+        vector<modAlphaCipher> ciphers = {modAlphaCipher(L"ГРОМ"), modAlphaCipher(L"ЗИМНИЙ"),
+                                          modAlphaCipher(L"Б"), modAlphaCipher(L"ВСЕМПРИВЕТМИР")};
+        vector<wstring> out = modAlphaCipher::encryptMany(ciphers, text);
+        CHECK_EQUAL(ciphers.size(), out.size());
+        for (size_t k = 0; k < ciphers.size(); ++k)
+            CHECK_WIDE_EQUAL(ciphers[k].encrypt(text), out[k]);
+        CHECK(modAlphaCipher::encryptMany({}, text).empty());
+    }
+
+    TEST(EmptyText) {
+        CHECK_THROW(modAlphaCipher::encryptMany({modAlphaCipher(L"ГРОМ")}, L"2025, hello!"), cipher_error);
+    }
+}
+
+SUITE(RekeyTest)
+{
+    TEST(MatchesDecryptThenEncrypt) {
+        const wstring plain = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОКДАВЫПЕЙЧАЮ";
+        const wstring keys[][2] = {{L"ГРОМ", L"ЗИМНИЙ"}, {L"ЗИМНИЙ", L"Б"}, {L"ПРИВЕТ", L"ПРИВЕТ"},
+                                   {L"ВСЕМПРИВЕТСЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОКД", L"АБ"}};
+        for (auto& k : keys) {
+            modAlphaCipher from(k[0]), to(k[1]);
+            CHECK_WIDE_EQUAL(to.encrypt(plain), modAlphaCipher::rekey(from, to, from.encrypt(plain)));
+        }
+    }
+
+    TEST(Errors) {
+        modAlphaCipher from(L"ГРОМ"), to(L"ЗИМА");
+        CHECK_THROW(modAlphaCipher::rekey(from, to, L""), cipher_error);
+        CHECK_THROW(modAlphaCipher::rekey(from, to, L"ТБЧ ОЗГ"), cipher_error);
+    }
+}
+
+SUITE(ViewTest)
+{
+    TEST(MatchesDecrypt) {
+        modAlphaCipher cp(L"ЗИМНИЙ");
+        wstring cipher = cp.encrypt(L"Съешь же ещё этих мягких французских булок, да выпей чаю");
+        auto view = cp.decryptView(cipher);
+        CHECK_EQUAL(cipher.size(), view.size());
+        CHECK_WIDE_EQUAL(cp.decrypt(cipher), wstring(view.begin(), view.end()));
+        CHECK(view[3] == L'Ш');
+        CHECK(*(view.end() - 1) == L'Ю');
+        CHECK(cp.decryptView(L"").empty());
+    }
+
+    TEST(SearchStopsAtMatch) {
+        // после совпадения идёт недопустимый шифротекст: поиск до него не доходит
+        modAlphaCipher cp(L"ГРОМ");
+        wstring cipher = cp.encrypt(L"ВСЕМПРИВЕТМИР") + L"??";
+        auto view = cp.decryptView(cipher);
+        const wstring needle = L"ПРИВЕТ";
+        auto it = search(view.begin(), view.end(), needle.begin(), needle.end());
+        CHECK_EQUAL(4, it - view.begin());
+        CHECK_THROW(wstring(view.begin(), view.end()), cipher_error);
+    }
+}
+
+SUITE(ContainerTest)
+{
+    const char* PATH = "container_test.bin";
+
+    TEST(RandomAccessDecrypt) {
+        wstring plain;
+        for (int i = 0; i < 200; ++i)
+            plain += L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК";
+        modAlphaCipher cp(L"ЗИМНИЙ");
+        CipherContainer::write(PATH, cp.encrypt(plain), CipherType::Gronsfeld, 6, 100);
+        {
+            CipherContainer box(PATH);
+            CHECK(box.cipherType() == CipherType::Gronsfeld);
+            CHECK_EQUAL(6u, box.keyHint());
+            CHECK_EQUAL(plain.size(), box.size());
+            CHECK_EQUAL((plain.size() + 101) / 102, box.blockCount());
+            CHECK_WIDE_EQUAL(cp.encrypt(plain), box.read(0, plain.size()));
+            const size_t ranges[][2] = {{0, 1}, {1, 5}, {101, 3}, {97, 250}, {plain.size() - 7, 7}};
+            for (auto& r : ranges)
+                CHECK_WIDE_EQUAL(plain.substr(r[0], r[1]), box.decrypt(cp, r[0], r[1]));
+            CHECK_THROW(box.read(plain.size() - 1, 2), cipher_error);
+            CHECK_THROW(box.decrypt(modAlphaCipher(L"ГРОМ"), 0, 4), cipher_error);
+        }
+        remove(PATH);
+    }
+
+    TEST(InvalidFiles) {
+        CHECK_THROW(CipherContainer("no_such_container.bin"), cipher_error);
+        CHECK_THROW(CipherContainer::write(PATH, L"ПРИ ВЕТ", CipherType::Table, 3), cipher_error);
+        {
+            ofstream out(PATH, ios::binary);
+            out << "RC33 not a container";
+        }
+        CHECK_THROW(CipherContainer c(PATH), cipher_error);
+        remove(PATH);
+    }
+}
+
 int main()
 {
     return UnitTest::RunAllTests();
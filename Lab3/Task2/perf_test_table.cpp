@@ -0,0 +1,83 @@
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include "table.h"
+#include "tablePlan.h"
+#include "../perf.h"
+using namespace std;
+
+const size_t LETTERS = 1 << 20;
+
+SUITE(ThroughputTest)
+{
+    TEST(EncryptMixedText) {
+        wstring text = perf::corpus(LETTERS, true);
+        Table cp(7);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.encrypt(text); });
+        CHECK(perf::baseline().accept("table.encrypt", r));
+    }
+
+    TEST(DecryptCipherText) {
+        wstring text = perf::corpus(LETTERS, false);
+        Table cp(7);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decrypt(text); });
+        CHECK(perf::baseline().accept("table.decrypt", r));
+    }
+
+    TEST(WideTable) {
+        wstring text = perf::corpus(LETTERS, false);
+        Table cp(1000);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decrypt(text); });
+        CHECK(perf::baseline().accept("table.decrypt_wide", r));
+    }
+
+    TEST(EightColumnsTranspose) {
+        wstring text = perf::corpus(LETTERS, false);
+        Table cp(8);
+        perf::Result enc = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.encrypt(text); });
+        CHECK(perf::baseline().accept("table.encrypt_8cols", enc));
+        perf::Result dec = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decrypt(text); });
+        CHECK(perf::baseline().accept("table.decrypt_8cols", dec));
+    }
+
+    TEST(DecryptUtf8) {
+        // пропускная способность в тех же единицах, что и для wchar_t: буквы * sizeof(wchar_t)
+        wstring text = perf::corpus(LETTERS, false);
+        string utf8;
+        for (auto c : text) {
+            utf8.push_back(rus::utf8Lead(rus::upperIndex(c)));
+            utf8.push_back(rus::utf8Trail(rus::upperIndex(c)));
+        }
+        Table cp(7);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decryptUtf8(utf8); });
+        CHECK(perf::baseline().accept("table.decrypt_utf8", r));
+    }
+
+    TEST(DecryptPlan) {
+        // три прохода Table одним проходом по заранее вычисленной перестановке
+        wstring text = perf::corpus(LETTERS, false);
+        TablePlan plan({7, 11, 13}, text.size());
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { plan.decrypt(text); });
+        CHECK(perf::baseline().accept("table.decrypt_plan3", r));
+    }
+
+    TEST(DecryptInPlace) {
+        // каждый вызов переставляет тот же буфер: текст остаётся допустимым шифротекстом
+        wstring text = perf::corpus(LETTERS, false);
+        Table cp(7);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decryptInPlace(text); });
+        CHECK(perf::baseline().accept("table.decrypt_inplace", r));
+    }
+
+    TEST(DecryptInPlaceWide) {
+        // при cols > 128 плитки по 16 строк переставляются через буфер в куче
+        wstring text = perf::corpus(LETTERS, false);
+        Table cp(129);
+        perf::Result r = perf::measure(text.size() * sizeof(wchar_t), [&] { cp.decryptInPlace(text); });
+        CHECK(perf::baseline().accept("table.decrypt_inplace_wide", r));
+    }
+}
+
+int main()
+{
+    return UnitTest::RunAllTests();
+}
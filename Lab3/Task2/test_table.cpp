@@ -2,7 +2,16 @@
 #include <string>
 #include <locale>
 #include <codecvt>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
 #include "table.h"
+#include "modAlphaCipher.h"
+#include "countingResource.h"
+#include "fixedCipher.h"
+#include "tablePlan.h"
+#include "cipherContainer.h"
 using namespace std;
 
 string wideToUtf8(const wstring& ws) {
@@ -132,6 +141,297 @@ SUITE(DecryptTest)
     }
 }
 
+SUITE(AllocatorTest)
+{
+    TEST(ArenaMatchesDefault) {
+        std::pmr::monotonic_buffer_resource arena;
+        Table t(5);
+        CHECK_WIDE_EQUAL(L"ПТМЕЕВСИВР", wstring(t.encrypt(L"Все, мпри вет!", &arena)));
+        CHECK_WIDE_EQUAL(L"ВСЕМПРИВЕТ", wstring(t.decrypt(L"ПТМЕЕВСИВР", &arena)));
+    }
+
+    TEST(ArenaErrors) {
+        std::pmr::monotonic_buffer_resource arena;
+        Table t(3);
+        CHECK_THROW(t.encrypt(L"2025!", &arena), cipher_error);
+        CHECK_THROW(t.decrypt(L"", &arena), cipher_error);
+        CHECK_THROW(t.decrypt(L"ПРИ ВЕТ", &arena), cipher_error);
+    }
+
+    TEST(NoSteadyStateAllocations) {
+        static std::byte buf[1 << 14];
+        CountingResource counter;
+        std::pmr::monotonic_buffer_resource arena(buf, sizeof buf, &counter);
+        Table t(4);
+        for (int request = 0; request < 100; ++request) {
+            std::pmr::wstring c = t.encrypt(L"Съешь же ещё этих мягких французских булок", &arena);
+            CHECK_WIDE_EQUAL(L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК", wstring(t.decrypt(c, &arena)));
+            arena.release();
+        }
+        CHECK_EQUAL(0u, counter.allocations());
+    }
+}
+
+SUITE(SharedInstanceTest)
+{
+    TEST(ConstInstanceAcrossThreads) {
+        const Table t(4);
+        const wstring expected = t.encrypt(L"Съешь же ещё этих мягких французских булок");
+        vector<int> mismatches(4, 0);
+        vector<thread> pool;
+        for (int k = 0; k < 4; ++k) {
+            pool.emplace_back([&, k] {
+                for (int i = 0; i < 1000; ++i) {
+                    wstring c = t.encrypt(L"Съешь же ещё этих мягких французских булок");
+                    if (c != expected || t.decrypt(c) != L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК")
+                        mismatches[k]++;
+                }
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+        for (int k = 0; k < 4; ++k)
+            CHECK_EQUAL(0, mismatches[k]);
+    }
+}
+
+static_assert(FixedTable<5>::encrypt(L"Все, мпри вет!").view() == L"ПТМЕЕВСИВР", "шифрование литерала при компиляции");
+static_assert(FixedTable<5>::decrypt(L"ПТМЕЕВСИВР").view() == L"ВСЕМПРИВЕТ", "расшифровывание литерала при компиляции");
+static_assert(FixedTable<11>::encrypt(L"ВСЕМПРИВЕТ").view() == L"ТЕВИРПМЕСВ", "ключ больше длины текста");
+
+SUITE(FixedColumnsTest)
+{
+    TEST(MatchesRuntimeCipher) {
+        const wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю";
+        const wstring letters = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОКДАВЫПЕЙЧАЮ";
+        CHECK_WIDE_EQUAL(Table(4).encrypt(text), FixedTable<4>::encrypt(text));
+        CHECK_WIDE_EQUAL(Table(4).encrypt(letters), FixedTable<4>::encrypt(letters));
+        CHECK_WIDE_EQUAL(Table(7).encrypt(letters), FixedTable<7>::encrypt(letters));
+        CHECK_WIDE_EQUAL(letters, FixedTable<7>::decrypt(Table(7).encrypt(letters)));
+        CHECK_WIDE_EQUAL(Table(16).decrypt(letters), FixedTable<16>::decrypt(letters));
+        CHECK_WIDE_EQUAL(Table(64).decrypt(letters), FixedTable<64>::decrypt(letters));
+    }
+
+    TEST(Errors) {
+        CHECK_THROW(FixedTable<3>::encrypt(wstring(L"2025!")), cipher_error);
+        CHECK_THROW(FixedTable<3>::decrypt(wstring()), cipher_error);
+        CHECK_THROW(FixedTable<3>::decrypt(wstring(L"ПРИ ВЕТ")), cipher_error);
+    }
+}
+
+SUITE(InPlaceTest)
+{
+    TEST(MatchesCopyingCipher) {
+        const wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю";
+        for (int cols = 2; cols < 60; ++cols) {
+            Table t(cols);
+            wstring work = text;
+            t.encryptInPlace(work);
+            CHECK_WIDE_EQUAL(t.encrypt(text), work);
+            t.decryptInPlace(work);
+            CHECK_WIDE_EQUAL(t.decrypt(t.encrypt(text)), work);
+        }
+    }
+
+    TEST(LongTextAcrossTilesAndWideTables) {
+        // несколько плиток с остатком строк и неполной строкой; 300 столбцов — обход по буквам
+        wstring text;
+        for (int i = 0; i < 20011; ++i)
+            text.push_back(L'А' + (i * 7 + i / 33) % 32);
+        for (int cols : {2, 7, 16, 33, 128, 129, 300}) {
+            Table t(cols);
+            wstring work = text;
+            t.encryptInPlace(work);
+            CHECK(t.encrypt(text) == work);
+            t.decryptInPlace(work);
+            CHECK(text == work);
+        }
+    }
+
+    TEST(ErrorsLeaveTextUnchanged) {
+        Table t(3);
+        wstring digits = L"2025!";
+        CHECK_THROW(t.encryptInPlace(digits), cipher_error);
+        CHECK_WIDE_EQUAL(L"2025!", digits);
+        wstring bad = L"ПРИ ВЕТ";
+        CHECK_THROW(t.decryptInPlace(bad), cipher_error);
+        CHECK_WIDE_EQUAL(L"ПРИ ВЕТ", bad);
+        wstring empty;
+        CHECK_THROW(t.decryptInPlace(empty), cipher_error);
+    }
+}
+
+SUITE(TransposeTest)
+{
+    TEST(SmallWidthsOnLongText) {
+        wstring text;
+        for (int i = 0; i < 1000; ++i)
+            text.push_back(modAlphaCipher::alphabet[(i * 7 + i / 33) % 33]);
+        for (int cols = 2; cols <= 20; ++cols) {
+            for (size_t n : {size_t(1000), size_t(997), size_t(129), size_t(64)}) {
+                wstring plain = text.substr(0, n);
+                Table t(cols);
+                wstring cipher = t.encrypt(plain);
+                bool positionsMatch = true;
+                for (size_t i = 0; i < n; ++i)
+                    positionsMatch = positionsMatch && cipher[Table::cipherPos(i, n, cols)] == plain[i];
+                CHECK(positionsMatch);
+                CHECK_WIDE_EQUAL(plain, t.decrypt(cipher));
+            }
+        }
+    }
+}
+
+SUITE(Utf8Test)
+{
+    TEST(MatchesWideCipher) {
+        const wstring texts[] = {L"Съешь же ещё этих мягких французских булок, да выпей чаю",
+                                 L"Ёлка и ЁЖ: 2025 год \x263a\x1f600 Ω", L"ВСЕМПРИВЕТ"};
+        for (const auto& text : texts) {
+            for (int cols : {2, 3, 5, 8, 100}) {
+                Table t(cols);
+                wstring cipher = t.encrypt(text);
+                CHECK_EQUAL(wideToUtf8(cipher), t.encryptUtf8(wideToUtf8(text)));
+                CHECK_EQUAL(wideToUtf8(t.decrypt(cipher)), t.decryptUtf8(wideToUtf8(cipher)));
+            }
+        }
+    }
+
+    TEST(Errors) {
+        Table t(3);
+        CHECK_THROW(t.encryptUtf8("2025, hello!"), cipher_error);
+        CHECK_THROW(t.decryptUtf8(""), cipher_error);
+        CHECK_THROW(t.decryptUtf8(wideToUtf8(L"ПРИ ВЕТ")), cipher_error);
+        CHECK_THROW(t.decryptUtf8(wideToUtf8(L"привет")), cipher_error);
+        CHECK_THROW(t.decryptUtf8(wideToUtf8(L"ПРИВЕТ") + "\xd0"), cipher_error);
+    }
+
+    TEST(InvalidSequencesAreSkipped) {
+        Table t(2);
+        CHECK_EQUAL(wideToUtf8(L"БАЯ"), t.encryptUtf8("\xd0\x90\xd0" "A\xd0\x91\xff\xd0\xaf"));
+    }
+}
+
+SUITE(RangeTest)
+{
+    TEST(ContainerRangeDecrypt) {
+        const char* PATH = "container_table_test.bin";
+        wstring plain;
+        for (int i = 0; i < 50; ++i)
+            plain += L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК";
+        Table t(7);
+        CipherContainer::write(PATH, t.encrypt(plain), CipherType::Table, 7, 99);
+        {
+            CipherContainer box(PATH);
+            CHECK(box.cipherType() == CipherType::Table);
+            const size_t ranges[][2] = {{0, 1}, {3, 5}, {100, 400}, {0, plain.size()}, {plain.size() - 9, 9}};
+            for (auto& r : ranges)
+                CHECK_WIDE_EQUAL(plain.substr(r[0], r[1]), box.decrypt(t, r[0], r[1]));
+            CHECK_THROW(box.decrypt(Table(6), 0, 4), cipher_error);
+            CHECK_THROW(box.decrypt(modAlphaCipher(L"ГРОМ"), 0, 4), cipher_error);
+            CHECK_THROW(box.decrypt(t, plain.size() - 1, 2), cipher_error);
+        }
+        remove(PATH);
+    }
+
+    TEST(MatchesFullDecrypt) {
+        wstring plain;
+        for (int i = 0; i < 300; ++i)
+            plain.push_back(modAlphaCipher::alphabet[(i * 5 + i / 33) % 33]);
+        for (int cols : {2, 3, 7, 16, 299, 500}) {
+            Table t(cols);
+            wstring cipher = t.encrypt(plain);
+            const size_t ranges[][2] = {{0, 1}, {0, 300}, {1, 17}, {150, 150}, {299, 1}, {42, 0}};
+            for (auto& r : ranges)
+                CHECK_WIDE_EQUAL(plain.substr(r[0], r[1]), t.decryptRange(cipher, r[0], r[1]));
+        }
+    }
+
+    TEST(Errors) {
+        Table t(3);
+        CHECK_THROW(t.decryptRange(L"", 0, 0), cipher_error);
+        CHECK_THROW(t.decryptRange(L"ПРИВЕТ", 5, 2), cipher_error);
+        CHECK_THROW(t.decryptRange(L"ПРИВЕТ", 7, 0), cipher_error);
+        CHECK_THROW(t.decryptRange(L"ПРИ ВЕТ", 0, 7), cipher_error);
+        // проверяются только прочитанные буквы
+        CHECK_WIDE_EQUAL(L"РИ", t.decryptRange(L"ИТРЕП ", 1, 2));
+    }
+}
+
+SUITE(ViewTest)
+{
+    TEST(MatchesDecrypt) {
+        const wstring plain = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОК";
+        for (int cols : {2, 5, 8, 100}) {
+            Table t(cols);
+            wstring cipher = t.encrypt(plain);
+            auto view = t.decryptView(cipher);
+            CHECK_WIDE_EQUAL(plain, wstring(view.begin(), view.end()));
+            CHECK(view[plain.size() - 1] == L'К');
+        }
+        CHECK(Table(3).decryptView(L"").empty());
+    }
+
+    TEST(SearchReadsOnlyNeededLetters) {
+        // ПРИВЕТ при 3 столбцах: ИТРЕПВ; буква В (позиция 3) из шифротекста не читается
+        Table t(3);
+        auto view = t.decryptView(L"ИТРЕП?");
+        const wstring needle = L"РИ";
+        CHECK_EQUAL(1, search(view.begin(), view.end(), needle.begin(), needle.end()) - view.begin());
+        CHECK_THROW(wstring(view.begin(), view.end()), cipher_error);
+    }
+}
+
+SUITE(PlanTest)
+{
+    TEST(MatchesChainedTables) {
+        const wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю";
+        const vector<int> chains[] = {{3}, {3, 5}, {7, 2, 4}, {100, 6}, {2, 2, 2, 2}};
+        for (const auto& keys : chains) {
+            wstring expected = text;
+            for (int key : keys)
+                expected = Table(key).encrypt(expected);
+            TablePlan plan(keys, expected.size());
+            CHECK_EQUAL(expected.size(), plan.size());
+            CHECK_WIDE_EQUAL(expected, plan.encrypt(text));
+            wstring back = expected;
+            for (auto key = keys.rbegin(); key != keys.rend(); ++key)
+                back = Table(*key).decrypt(back);
+            CHECK_WIDE_EQUAL(back, plan.decrypt(expected));
+        }
+    }
+
+    TEST(Errors) {
+        CHECK_THROW(TablePlan({}, 5), cipher_error);
+        CHECK_THROW(TablePlan({3, 1}, 5), cipher_error);
+        CHECK_THROW(TablePlan({3}, 0), cipher_error);
+        TablePlan plan({3, 4}, 6);
+        CHECK_WIDE_EQUAL(Table(4).encrypt(Table(3).encrypt(L"Привет!")), plan.encrypt(L"Привет!"));
+        CHECK_THROW(plan.encrypt(L"Прив"), cipher_error);
+        CHECK_THROW(plan.encrypt(L"Привет, мир"), cipher_error);
+        CHECK_THROW(plan.encrypt(L"12345"), cipher_error);
+        CHECK_THROW(plan.decrypt(L"ПРИВЕТМ"), cipher_error);
+        CHECK_THROW(plan.decrypt(L"ПРИ ВЕ"), cipher_error);
+        CHECK_THROW(plan.decrypt(L""), cipher_error);
+    }
+}
+
+SUITE(TryTest)
+{
+    TEST(SuccessAndErrors) {
+        CHECK(Table::tryCreate(1).error().code == CipherErrc::InvalidColumns);
+        auto t = Table::tryCreate(3);
+        CHECK(t.ok());
+        CHECK_WIDE_EQUAL(L"ИТРЕПВ", t.value().tryEncrypt(L"Привет!").value());
+        CHECK_WIDE_EQUAL(L"ПРИВЕТ", t.value().tryDecrypt(L"ИТРЕПВ").value());
+        CHECK(t.value().tryEncrypt(L"2025").error().code == CipherErrc::EmptyOpenText);
+        CHECK(t.value().tryDecrypt(L"").error().code == CipherErrc::EmptyCipherText);
+        auto bad = t.value().tryDecrypt(L"ИТРЕПв");
+        CHECK(bad.error().code == CipherErrc::InvalidCipherText);
+        CHECK_EQUAL(5u, bad.error().position);
+    }
+}
+
 int main()
 {
     return UnitTest::RunAllTests();
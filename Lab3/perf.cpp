@@ -0,0 +1,169 @@
+/** @file perf.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Реализация слоя нагрузочных тестов
+ * @details Подсчёт выделений памяти через замену operator new, тестовый текст,
+ * калибровочный цикл и файл базовых значений.
+ */
+#include "perf.h"
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+// файл базовых значений; Makefile задаёт абсолютный путь
+#ifndef PERF_BASELINE
+#define PERF_BASELINE "../perf_baseline.txt"
+#endif
+
+namespace {
+
+std::atomic<std::size_t> counter{0};
+
+const char CALIBRATION[] = "calibration"; ///< имя строки калибровки в файле базовых значений
+
+/** @brief Пропускная способность калибровочного цикла на этой машине
+ * @details Побуквенная замена по таблице в тексте из 1M букв с записью в другой буфер;
+ * каждая буква зависит от предыдущей, поэтому цикл не векторизуется и его скорость
+ * определяется ядром процессора и памятью, как у замеров шифров.
+ */
+double calibrate()
+{
+    std::wstring src = perf::corpus(1 << 20, false), dst(src.size(), L'\0');
+    wchar_t table[256];
+    for (int i = 0; i < 256; ++i)
+        table[i] = wchar_t(i * 7 + 1);
+    perf::Result r = perf::measure(src.size() * sizeof(wchar_t), [&] {
+        wchar_t prev = 0;
+        for (std::size_t i = 0; i < src.size(); ++i)
+            prev = dst[i] = table[(src[i] + prev) & 255];
+    });
+    return r.mbPerSec;
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    counter.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace perf {
+
+std::size_t allocationCount()
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+std::wstring corpus(std::size_t letters, bool mixed)
+{
+    const std::wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    const std::wstring lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+    const std::wstring other = L" ,.!?-1";
+    std::wstring text;
+    text.reserve(mixed ? letters + letters / 4 : letters);
+    uint32_t state = 12345;
+    for (std::size_t i = 0; i < letters; ++i) {
+        state = state * 1664525u + 1013904223u;
+        uint32_t r = state >> 8;
+        if (!mixed) {
+            text.push_back(upper[r % upper.size()]);
+            continue;
+        }
+        text.push_back((r & 0x100) ? lower[r % lower.size()] : upper[r % upper.size()]);
+        if ((r & 0x3000) == 0)
+            text.push_back(other[(r >> 16) % other.size()]);
+    }
+    return text;
+}
+
+Baseline::Baseline(const std::string& file):
+    path(file), tolerance(0.3), update(false), calibration(calibrate()), scale(1)
+{
+    if (const char* t = std::getenv("PERF_TOLERANCE"))
+        tolerance = std::atof(t);
+    if (const char* u = std::getenv("PERF_UPDATE"))
+        update = std::string(u) == "1";
+
+    std::ifstream in(path);
+    std::string name;
+    Result r;
+    while (in >> name >> r.mbPerSec >> r.allocations)
+        values[name] = r;
+    auto it = values.find(CALIBRATION);
+    if (it != values.end()) {
+        if (it->second.mbPerSec > 0)
+            scale = calibration / it->second.mbPerSec;
+        values.erase(it);
+    }
+    std::cout << "калибровка " << std::fixed << std::setprecision(1) << calibration
+              << " МБ/с, базовые значения умножаются на " << std::setprecision(2) << scale << std::endl;
+}
+
+Baseline::~Baseline()
+{
+    if (!update)
+        return;
+    // не замеренные в этом запуске значения приводятся к калибровке этой машины
+    for (auto& v : values) {
+        if (!updated.count(v.first))
+            v.second.mbPerSec *= scale;
+    }
+    values[CALIBRATION] = Result{calibration, 0};
+    std::ofstream out(path);
+    for (const auto& v : values)
+        out << v.first << ' ' << std::fixed << std::setprecision(1) << v.second.mbPerSec
+            << ' ' << v.second.allocations << '\n';
+}
+
+bool Baseline::accept(const std::string& name, const Result& r)
+{
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << r.mbPerSec << " МБ/с " << std::setw(6) << r.allocations << " выделений";
+    auto it = values.find(name);
+    if (update || it == values.end()) {
+        std::cout << (update ? "  (записано)" : "  (нет базового значения)") << std::endl;
+        if (update) {
+            values[name] = r;
+            updated.insert(name);
+        }
+        return true;
+    }
+
+    const Result& base = it->second;
+    const double expected = base.mbPerSec * scale;
+    bool fastEnough = r.mbPerSec >= expected * (1 - tolerance);
+    bool fewAllocations = r.allocations <= base.allocations;
+    std::cout << "  база " << expected << " МБ/с " << base.allocations << " выделений";
+    if (!fastEnough)
+        std::cout << "  ПАДЕНИЕ ПРОПУСКНОЙ СПОСОБНОСТИ";
+    if (!fewAllocations)
+        std::cout << "  РОСТ ЧИСЛА ВЫДЕЛЕНИЙ";
+    std::cout << std::endl;
+    return fastEnough && fewAllocations;
+}
+
+Baseline& baseline()
+{
+    static Baseline b(PERF_BASELINE);
+    return b;
+}
+
+} // namespace perf
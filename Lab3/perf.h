@@ -0,0 +1,110 @@
+/** @file perf.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Нагрузочные тесты шифров
+ * @details Общий для Lab3/Task1 и Lab3/Task2 слой замеров: пропускная способность,
+ * число выделений памяти и сравнение с базовыми значениями perf_baseline.txt.
+ */
+#pragma once
+#include <string>
+#include <map>
+#include <set>
+#include <chrono>
+#include <cstddef>
+
+/** @brief Слой нагрузочных тестов поверх UnitTest++
+ * @details Замеряет пропускную способность (МБ/с входного wstring) и число выделений памяти
+ * за вызов и сравнивает их с базовыми значениями из файла perf_baseline.txt.
+ * Абсолютные МБ/с зависят от машины, поэтому в файле хранится и пропускная способность
+ * калибровочного цикла; базовые значения умножаются на отношение текущей калибровки
+ * к записанной, и допуск применяется к приведённым значениям.
+ * Переменные окружения:
+ *  - PERF_TOLERANCE — допустимое падение пропускной способности (доля, по умолчанию 0.3);
+ *  - PERF_UPDATE=1 — записать измеренные значения в файл вместо проверки.
+ */
+namespace perf {
+
+/** @brief Результат замера */
+struct Result {
+    double mbPerSec;         ///< пропускная способность, МБ входных данных в секунду
+    std::size_t allocations; ///< число выделений памяти за один вызов
+};
+
+/** @brief Счётчик вызовов operator new с начала программы */
+std::size_t allocationCount();
+
+/** @brief Детерминированный текст для замеров
+ * @param letters Количество букв
+ * @param mixed true — строчные и прописные буквы с пробелами и знаками препинания,
+ * false — только прописные буквы (валидный шифротекст)
+ * @return Сгенерированный текст
+ */
+std::wstring corpus(std::size_t letters, bool mixed);
+
+/** @brief Замер вызова
+ * @details Функция вызывается один раз для подсчёта выделений памяти,
+ * затем повторяется, пока суммарное время не превысит 0.2 с; берётся лучшее время.
+ * @param bytes Объём входных данных одного вызова в байтах
+ * @param fn Замеряемая функция
+ * @return Результат замера
+ */
+template <class F>
+Result measure(std::size_t bytes, F&& fn)
+{
+    using clock = std::chrono::steady_clock;
+    std::size_t before = allocationCount();
+    fn();
+    std::size_t allocations = allocationCount() - before;
+
+    double best = 1e300;
+    double total = 0;
+    while (total < 0.2) {
+        auto start = clock::now();
+        fn();
+        double sec = std::chrono::duration<double>(clock::now() - start).count();
+        total += sec;
+        if (sec < best)
+            best = sec;
+    }
+    return Result{bytes / best / 1e6, allocations};
+}
+
+/** @brief Базовые значения замеров */
+class Baseline
+{
+private:
+    std::string path;                     ///< путь к файлу базовых значений
+    std::map<std::string, Result> values; ///< базовые значения по имени замера
+    double tolerance;                     ///< допустимое падение пропускной способности
+    bool update;                          ///< режим записи новых базовых значений
+    double calibration;                   ///< пропускная способность калибровочного цикла, МБ/с
+    double scale;                         ///< текущая калибровка, делённая на записанную в файле
+    std::set<std::string> updated;        ///< замеры, записанные в этом запуске
+
+public:
+    /** @brief Загрузка файла базовых значений и калибровка
+     * @param file Путь к файлу: строки вида "имя МБ/с выделения",
+     * строка "calibration МБ/с 0" — калибровка машины, на которой записан файл
+     */
+    explicit Baseline(const std::string& file);
+    /** @brief В режиме обновления записывает файл
+     * @details Значения, не замеренные в этом запуске, приводятся к текущей калибровке
+     */
+    ~Baseline();
+    /** @brief Проверка замера
+     * @param name Имя замера
+     * @param r Результат замера
+     * @return true, если пропускная способность не упала больше допустимого
+     * и выделений памяти не больше базового значения; в режиме обновления всегда true
+     */
+    bool accept(const std::string& name, const Result& r);
+};
+
+/** @brief Общий объект базовых значений
+ * @details Путь к файлу задаёт макрос PERF_BASELINE: Makefile передаёт абсолютный путь
+ * к Lab3/perf_baseline.txt, поэтому тесты не зависят от текущего каталога
+ */
+Baseline& baseline();
+
+} // namespace perf
@@ -0,0 +1,416 @@
+/** @file keyAnalysis.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Реализация класса KeyAnalyzer
+ */
+#include "keyAnalysis.h"
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+namespace {
+
+/** @brief Частотный индекс совпадений открытого русского текста */
+const double RUSSIAN_IC = 0.0553;
+/** @brief Индекс совпадений случайного текста над алфавитом из 33 букв */
+const double RANDOM_IC = 1.0 / 33;
+/** @brief Начальное число ячеек таблицы последних вхождений n-грамм */
+const size_t NGRAM_SLOTS = size_t(1) << 16;
+/** @brief Наибольшее число ячеек таблицы последних вхождений n-грамм (32 МБ) */
+const size_t NGRAM_MAX_SLOTS = size_t(1) << 21;
+/** @brief Расстояния меньше этого значения копятся в гистограмме, большие — сразу в счётчики периодов */
+const size_t SHORT_DISTANCES = size_t(1) << 16;
+/** @brief Наибольшее число букв, которое поток считает в 32-битные счётчики до слияния в общие */
+const size_t COUNTER_SLICE = size_t(1) << 31;
+/** @brief Блок текста, по которому обновляются гистограммы всех периодов */
+const size_t HIST_BLOCK = 4096;
+/** @brief Наименьший фрагмент текста на поток при построении гистограмм */
+const size_t MIN_CHUNK = size_t(1) << 16;
+
+/** @brief Ячейка таблицы последних вхождений n-грамм */
+struct NgramSlot {
+    uint64_t code; ///< n-грамма в виде числа по основанию 33
+    size_t pos;    ///< позиция последнего вхождения, SIZE_MAX для пустой ячейки
+};
+
+/** @brief Таблица последних вхождений n-грамм с открытой адресацией
+ * @details В ячейке хранится сама n-грамма, поэтому разные n-граммы с одинаковым хешем
+ * не подменяют друг друга: при коллизии пробуется следующая ячейка.
+ * Таблица удваивается, когда заполнена наполовину, но не больше NGRAM_MAX_SLOTS ячеек (32 МБ).
+ * Заполненная наполовину таблица наибольшего размера вытесняет старшую половину n-грамм —
+ * те, что встречались последний раз раньше остальных; на время вытеснения нужно ещё до 24 МБ.
+ * Поэтому повтор редкой n-граммы через миллионы позиций может быть не засчитан.
+ */
+class NgramTable
+{
+private:
+    vector<NgramSlot> slots; ///< ячейки, число — степень двойки
+    size_t used = 0;         ///< число занятых ячеек
+    int shift = 0;           ///< сдвиг мультипликативного хеша
+
+    /** @brief Ячейка для n-граммы: занятая ею или первая пустая на пути пробирования */
+    NgramSlot& find(uint64_t code)
+    {
+        size_t mask = slots.size() - 1;
+        size_t i = (code * 0x9E3779B97F4A7C15ULL) >> shift;
+        while (slots[i].pos != SIZE_MAX && slots[i].code != code)
+            i = (i + 1) & mask;
+        return slots[i];
+    }
+    /** @brief Удвоение таблицы с перестановкой занятых ячеек */
+    void grow()
+    {
+        vector<NgramSlot> old(slots.size() * 2, NgramSlot{0, SIZE_MAX});
+        old.swap(slots);
+        shift--;
+        for (const auto& slot : old) {
+            if (slot.pos != SIZE_MAX)
+                find(slot.code) = slot;
+        }
+    }
+    /** @brief Вытеснение n-грамм, последнее вхождение которых старше медианы */
+    void evict()
+    {
+        vector<size_t> positions;
+        positions.reserve(used);
+        for (const auto& slot : slots) {
+            if (slot.pos != SIZE_MAX)
+                positions.push_back(slot.pos);
+        }
+        auto middle = positions.begin() + positions.size() / 2;
+        nth_element(positions.begin(), middle, positions.end());
+        const size_t oldest = *middle;
+        positions = vector<size_t>();
+
+        vector<NgramSlot> kept;
+        kept.reserve(used - used / 2);
+        for (auto& slot : slots) {
+            if (slot.pos != SIZE_MAX && slot.pos >= oldest)
+                kept.push_back(slot);
+            slot.pos = SIZE_MAX;
+        }
+        used = kept.size();
+        for (const auto& slot : kept)
+            find(slot.code) = slot;
+    }
+
+public:
+    /** @brief Пустая таблица из NGRAM_SLOTS ячеек */
+    NgramTable(): slots(NGRAM_SLOTS, NgramSlot{0, SIZE_MAX}), shift(64 - 16) {}
+    /** @brief Запись вхождения n-граммы
+     * @return Позиция предыдущего вхождения или SIZE_MAX, если его не было
+     */
+    size_t update(uint64_t code, size_t pos)
+    {
+        NgramSlot* slot = &find(code);
+        if (slot->pos == SIZE_MAX) {
+            if (2 * (used + 1) > slots.size()) {
+                if (slots.size() < NGRAM_MAX_SLOTS)
+                    grow();
+                else
+                    evict();
+                slot = &find(code);
+            }
+            used++;
+            slot->code = code;
+        }
+        size_t prev = slot->pos;
+        slot->pos = pos;
+        return prev;
+    }
+};
+
+/** @brief Число рабочих потоков для заданного числа независимых задач */
+unsigned workerCount(size_t tasks)
+{
+    unsigned hw = thread::hardware_concurrency();
+    if (hw == 0)
+        hw = 1;
+    return static_cast<unsigned>(min<size_t>(hw, max<size_t>(tasks, 1)));
+}
+
+/** @brief Частоты букв русского текста в порядке алфавита modAlphaCipher::alphabet */
+const double RUSSIAN_FREQ[] = {
+    0.0801, 0.0159, 0.0454, 0.0170, 0.0298, 0.0845, 0.0004, 0.0094, 0.0165, 0.0735, 0.0121,
+    0.0349, 0.0440, 0.0321, 0.0670, 0.1097, 0.0281, 0.0473, 0.0547, 0.0626, 0.0262, 0.0026,
+    0.0097, 0.0048, 0.0144, 0.0073, 0.0036, 0.0004, 0.0190, 0.0174, 0.0032, 0.0064, 0.0201
+};
+/** @brief Число независимых таблиц при построении гистограмм */
+const int HIST_LANES = 4;
+
+/** @brief Гистограммы букв по классам вычетов номера позиции по модулю period
+ * @details Соседние строки таблицы (по period букв) пишут в разные копии гистограмм,
+ * чтобы подряд идущие инкременты одной ячейки не ждали друг друга через память;
+ * копии суммируются в конце.
+ * @return Вектор period * 33 счётчиков, класс c занимает элементы [c * 33, c * 33 + 33)
+ */
+vector<uint64_t> classHistograms(const vector<unsigned char>& nums, int period)
+{
+    const size_t m = modAlphaCipher::alphabet.size();
+    const size_t width = static_cast<size_t>(period) * m;
+    vector<uint64_t> lanes(HIST_LANES * width, 0);
+    const size_t n = nums.size();
+    const size_t whole = n - n % period;
+    size_t lane = 0;
+    for (size_t i = 0; i < whole; i += period) {
+        const unsigned char* row = nums.data() + i;
+        uint64_t* table = lanes.data() + lane * width;
+        for (int r = 0; r < period; ++r)
+            table[r * m + row[r]]++;
+        if (++lane == HIST_LANES)
+            lane = 0;
+    }
+    for (size_t i = whole; i < n; ++i)
+        lanes[(i - whole) * m + nums[i]]++;
+
+    vector<uint64_t> counts(lanes.begin(), lanes.begin() + width);
+    for (int l = 1; l < HIST_LANES; ++l) {
+        for (size_t k = 0; k < width; ++k)
+            counts[k] += lanes[l * width + k];
+    }
+    return counts;
+}
+
+/** @brief Смещение гистограмм периода p в общей таблице всех периодов 1..maxPeriod */
+size_t periodBase(int p)
+{
+    return static_cast<size_t>(p) * (p - 1) / 2 * modAlphaCipher::alphabet.size();
+}
+
+/** @brief Гистограммы классов вычетов сразу для всех периодов 1..maxPeriod на отрезке [begin, end)
+ * @details Текст читается из памяти один раз: блок из HIST_BLOCK букв загружается в кэш
+ * и по нему обновляются гистограммы каждого периода; номер класса каждого периода
+ * переносится между блоками.
+ * @param counts Таблица размера periodBase(maxPeriod + 1); класс c периода p занимает
+ * элементы [periodBase(p) + c * 33, periodBase(p) + c * 33 + 33). 32-битных счётчиков
+ * хватает, если отрезок не длиннее COUNTER_SLICE букв
+ */
+void allClassHistograms(const vector<unsigned char>& nums, size_t begin, size_t end,
+                        int maxPeriod, vector<uint32_t>& counts)
+{
+    const size_t m = modAlphaCipher::alphabet.size();
+    vector<size_t> cur(maxPeriod + 1);
+    for (int p = 1; p <= maxPeriod; ++p)
+        cur[p] = begin % p * m;
+    for (size_t block = begin; block < end; block += HIST_BLOCK) {
+        const unsigned char* text = nums.data() + block;
+        const size_t len = min(HIST_BLOCK, end - block);
+        for (int p = 1; p <= maxPeriod; ++p) {
+            uint32_t* hist = counts.data() + periodBase(p);
+            const size_t width = p * m;
+            size_t at = cur[p];
+            for (size_t i = 0; i < len; ++i) {
+                hist[at + text[i]]++;
+                at += m;
+                if (at == width)
+                    at = 0;
+            }
+            cur[p] = at;
+        }
+    }
+}
+
+/** @brief Индекс совпадений при заданном периоде: среднее по классам вычетов
+ * @param counts Гистограммы period классов подряд, по 33 счётчика
+ */
+double periodIndex(const uint64_t* counts, int period)
+{
+    const size_t m = modAlphaCipher::alphabet.size();
+    double sum = 0;
+    int classes = 0;
+    for (int c = 0; c < period; ++c) {
+        uint64_t total = 0;
+        double pairs = 0;
+        for (size_t k = 0; k < m; ++k) {
+            uint64_t f = counts[c * m + k];
+            total += f;
+            pairs += static_cast<double>(f) * (f - (f ? 1 : 0));
+        }
+        if (total > 1) {
+            sum += pairs / (static_cast<double>(total) * (total - 1));
+            classes++;
+        }
+    }
+    return classes ? sum / classes : 0;
+}
+
+} // namespace
+
+vector<unsigned char> KeyAnalyzer::toValidNums(const wstring& s)
+{
+    if (s.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    vector<unsigned char> result;
+    result.reserve(s.size());
+    for (auto c : s) {
+        int idx = rus::upperIndex(c);
+        if (idx < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        result.push_back(static_cast<unsigned char>(idx));
+    }
+    return result;
+}
+
+int KeyAnalyzer::getValidPeriod(int maxPeriod)
+{
+    if (maxPeriod < 1)
+        throw cipher_error("Недопустимый период: должен быть >= 1");
+    if (maxPeriod > MAX_PERIOD)
+        throw cipher_error("Недопустимый период: должен быть <= 256");
+    return maxPeriod;
+}
+
+KeyAnalyzer::KeyAnalyzer(const wstring& cipher)
+{
+    nums = toValidNums(cipher);
+}
+
+/** @brief Индекс совпадений: текст делится на фрагменты, поток строит гистограммы всех периодов
+ * для своего фрагмента в 32-битных счётчиках и по отрезкам не длиннее COUNTER_SLICE добавляет их
+ * в общие 64-битные; целые счётчики складываются, поэтому результат не зависит от числа потоков.
+ * Периоды длиннее текста не считаются: в их классах меньше двух букв */
+vector<double> KeyAnalyzer::coincidenceIndex(int maxPeriod) const
+{
+    getValidPeriod(maxPeriod);
+    const int periods = static_cast<int>(min<size_t>(maxPeriod, nums.size()));
+    const size_t width = periodBase(periods + 1);
+    unsigned workers = workerCount(nums.size() / MIN_CHUNK);
+    size_t chunk = (nums.size() + workers - 1) / workers;
+    vector<uint64_t> counts(width, 0);
+    mutex countsLock;
+
+    vector<thread> pool;
+    for (unsigned t = 0; t < workers; ++t) {
+        size_t begin = min(nums.size(), t * chunk);
+        size_t end = min(nums.size(), begin + chunk);
+        pool.emplace_back([&, begin, end] {
+            vector<uint32_t> partial(width);
+            for (size_t from = begin; from < end; from += COUNTER_SLICE) {
+                fill(partial.begin(), partial.end(), 0);
+                allClassHistograms(nums, from, min(end, from + COUNTER_SLICE), periods, partial);
+                lock_guard<mutex> lock(countsLock);
+                for (size_t k = 0; k < width; ++k)
+                    counts[k] += partial[k];
+            }
+        });
+    }
+    for (auto& th : pool)
+        th.join();
+
+    vector<double> ioc(maxPeriod + 1, 0);
+    for (int p = 1; p <= periods; ++p)
+        ioc[p] = periodIndex(counts.data() + periodBase(p), p);
+    return ioc;
+}
+
+/** @brief Метод Касиски: один проход по всему тексту; короткие расстояния между соседними
+ * вхождениями n-грамм копятся в гистограмме фиксированного размера, длинные сразу засчитываются
+ * делящим их периодам. Память — O(maxPeriod) плюс ограниченная таблица n-грамм */
+vector<size_t> KeyAnalyzer::kasiskiFactors(int maxPeriod, int ngram) const
+{
+    getValidPeriod(maxPeriod);
+    if (ngram < 2 || ngram > 12)
+        throw cipher_error("Недопустимая длина n-граммы");
+
+    const uint64_t m = modAlphaCipher::alphabet.size();
+    uint64_t topWeight = 1;
+    for (int k = 1; k < ngram; ++k)
+        topWeight *= m;
+
+    // Проверка делимости умножением (Lemire): p | d <=> d * ceil(2^64 / p) <= ceil(2^64 / p) - 1
+    vector<uint64_t> divisors(maxPeriod + 1, 0);
+    for (int p = 1; p <= maxPeriod; ++p)
+        divisors[p] = UINT64_MAX / p + 1;
+
+    const size_t n = nums.size();
+    vector<size_t> distances(SHORT_DISTANCES, 0);
+    vector<size_t> factors(maxPeriod + 1, 0);
+    NgramTable last;
+    uint64_t code = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i >= static_cast<size_t>(ngram))
+            code -= nums[i - ngram] * topWeight;
+        code = code * m + nums[i];
+        if (i + 1 < static_cast<size_t>(ngram))
+            continue;
+        size_t start = i + 1 - ngram;
+        size_t prev = last.update(code, start);
+        if (prev == SIZE_MAX)
+            continue;
+        uint64_t dist = start - prev;
+        if (dist < SHORT_DISTANCES) {
+            distances[dist]++;
+        } else {
+            for (int p = 1; p <= maxPeriod; ++p)
+                factors[p] += (dist * divisors[p] <= divisors[p] - 1);
+        }
+    }
+
+    for (int p = 1; p <= maxPeriod; ++p) {
+        for (size_t d = p; d < SHORT_DISTANCES; d += p)
+            factors[p] += distances[d];
+    }
+    return factors;
+}
+
+int KeyAnalyzer::estimateKeyLength(int maxPeriod) const
+{
+    vector<double> ioc = coincidenceIndex(maxPeriod);
+    const double threshold = (RUSSIAN_IC + RANDOM_IC) / 2;
+
+    int best = 1;
+    for (int p = 1; p <= maxPeriod; ++p) {
+        if (ioc[p] >= threshold)
+            return p;
+        if (ioc[p] > ioc[best])
+            best = p;
+    }
+    return best;
+}
+
+/** @brief Восстановление ключа: для каждого класса вычетов выбирается сдвиг с наименьшим хи-квадрат,
+ * результат проверяется modAlphaCipher::tryCreate */
+wstring KeyAnalyzer::recoverKey(int period) const
+{
+    if (period < 1)
+        throw cipher_error("Недопустимый период: должен быть >= 1");
+    if (static_cast<size_t>(period) > nums.size())
+        throw cipher_error("Недопустимый период: больше длины шифротекста"); // пустые классы дали бы NaN в хи-квадрат
+    const wstring& alphabet = modAlphaCipher::alphabet;
+    const size_t m = alphabet.size();
+    vector<uint64_t> counts = classHistograms(nums, period);
+
+    wstring key;
+    key.reserve(period);
+    for (int c = 0; c < period; ++c) {
+        const uint64_t* hist = counts.data() + c * m;
+        uint64_t total = 0;
+        for (size_t k = 0; k < m; ++k)
+            total += hist[k];
+
+        size_t bestShift = 0;
+        double bestScore = -1;
+        for (size_t shift = 0; shift < m; ++shift) {
+            double score = 0;
+            for (size_t k = 0; k < m; ++k) {
+                double expected = total * RUSSIAN_FREQ[k];
+                double diff = hist[(k + shift) % m] - expected;
+                score += diff * diff / expected;
+            }
+            if (bestScore < 0 || score < bestScore) {
+                bestScore = score;
+                bestShift = shift;
+            }
+        }
+        key.push_back(alphabet[bestShift]);
+    }
+    // больше половины нулевых сдвигов: такой ключ modAlphaCipher не принимает,
+    // значит шифротекст не получен им с этим периодом
+    if (!modAlphaCipher::tryCreate(key))
+        throw cipher_error("Восстановленный ключ вырожденный: больше половины классов без сдвига");
+    return key;
+}
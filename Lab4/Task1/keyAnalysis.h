@@ -0,0 +1,92 @@
+/** @file keyAnalysis.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Заголовочный файл модуля криптоанализа шифра Гронсфельда
+ * @details Определяет класс KeyAnalyzer, реализующий тест Фридмана
+ * (индекс совпадений), метод Касиски (расстояния между повторами n-грамм)
+ * и частотное восстановление ключа известной длины.
+ */
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "modAlphaCipher.h"
+
+/** @brief Анализ шифротекста Гронсфельда: оценка длины ключа и восстановление ключа
+ * @details Шифротекст один раз переводится в номера букв алфавита modAlphaCipher::alphabet,
+ * после чего для всех кандидатов периода считаются статистики.
+ * Гистограммы классов вычетов для всех периодов строятся за один проход,
+ * распараллеленный по фрагментам текста; поиск повторов — один проход по всему тексту.
+ * Результаты не зависят от числа потоков.
+ * @warning Реализация только для русского языка
+ */
+class KeyAnalyzer
+{
+private:
+    std::vector<unsigned char> nums; ///< шифротекст в виде номеров букв
+    /** @brief Валидация шифротекста и перевод в номера букв
+     * @param s Шифротекст. Должен содержать только прописные русские буквы
+     * @return Вектор номеров букв
+     * @throw cipher_error если текст пустой или содержит недопустимые символы
+     */
+    static std::vector<unsigned char> toValidNums(const std::wstring& s);
+    /** @brief Проверка границ кандидата периода
+     * @param maxPeriod Максимальный проверяемый период
+     * @return Валидное значение периода
+     * @throw cipher_error если maxPeriod < 1 или maxPeriod > MAX_PERIOD
+     */
+    static int getValidPeriod(int maxPeriod);
+
+public:
+    /** @brief Наибольший проверяемый период
+     * @details Гистограммы всех периодов до MAX_PERIOD занимают около 4 МБ
+     * 32-битных счётчиков на поток
+     */
+    static const int MAX_PERIOD = 256;
+    KeyAnalyzer() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор
+     * @param cipher Шифротекст, полученный modAlphaCipher::encrypt
+     * @throw cipher_error если шифротекст невалидный
+     */
+    explicit KeyAnalyzer(const std::wstring& cipher);
+    /** @brief Индекс совпадений для периодов 1..maxPeriod
+     * @param maxPeriod Максимальный проверяемый период
+     * @return Вектор размера maxPeriod + 1; элемент p — средний по классам вычетов
+     * индекс совпадений при периоде p (элемент 0 не используется); для периодов длиннее текста — 0
+     * @throw cipher_error если maxPeriod < 1 или maxPeriod > MAX_PERIOD
+     */
+    std::vector<double> coincidenceIndex(int maxPeriod) const;
+    /** @brief Метод Касиски
+     * @details Позиции n-грамм индексируются скользящим хешем в таблице с открытой адресацией,
+     * которая хранит сами n-граммы, поэтому коллизии хеша не теряют повторов.
+     * Таблица занимает не больше 32 МБ: при заполнении вытесняются n-граммы,
+     * встречавшиеся давнее других, и очень далёкие повторы могут быть не засчитаны;
+     * при повторе n-граммы расстояние до предыдущего вхождения засчитывается
+     * всем периодам, которые его делят.
+     * @param maxPeriod Максимальный проверяемый период
+     * @param ngram Длина n-граммы (от 2 до 12)
+     * @return Вектор размера maxPeriod + 1; элемент p — число расстояний, кратных p
+     * @throw cipher_error если maxPeriod < 1, maxPeriod > MAX_PERIOD или длина n-граммы вне допустимых границ
+     */
+    std::vector<std::size_t> kasiskiFactors(int maxPeriod, int ngram = 3) const;
+    /** @brief Оценка длины ключа
+     * @details Выбирается наименьший период, индекс совпадений которого близок
+     * к индексу открытого русского текста; если такого нет — период с наибольшим индексом.
+     * @param maxPeriod Максимальный проверяемый период
+     * @return Наиболее вероятная длина ключа
+     * @throw cipher_error если maxPeriod < 1 или maxPeriod > MAX_PERIOD
+     */
+    int estimateKeyLength(int maxPeriod) const;
+    /** @brief Восстановление ключа известной длины частотным анализом
+     * @details Для каждого класса вычетов строится гистограмма из 33 букв
+     * и перебираются все 33 сдвига; выбирается сдвиг с наименьшим значением
+     * хи-квадрат относительно частот букв русского языка.
+     * @param period Длина ключа
+     * @return Ключ, который всегда принимает конструктор modAlphaCipher
+     * @throw cipher_error если period < 1, больше длины шифротекста или восстановленный ключ
+     * вырожденный (больше половины букв «А»), то есть не принимается modAlphaCipher
+     * @warning Для короткого шифротекста ключ может оказаться неточным
+     */
+    std::wstring recoverKey(int period) const;
+};
@@ -0,0 +1,189 @@
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <map>
+#include <locale>
+#include <codecvt>
+#include "modAlphaCipher.h"
+#include "keyAnalysis.h"
+using namespace std;
+
+string wideToUtf8(const wstring& ws) {
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(ws);
+}
+
+#define CHECK_WIDE_EQUAL(expected, actual) \
+    CHECK_EQUAL(wideToUtf8(expected), wideToUtf8(actual))
+
+const wstring SAMPLE_TEXT =
+    L"Мой дядя самых честных правил, когда не в шутку занемог, он уважать себя заставил "
+    L"и лучше выдумать не мог. Его пример другим наука, но, боже мой, какая скука с больным "
+    L"сидеть и день и ночь, не отходя ни шагу прочь. Какое низкое коварство полуживого забавлять, "
+    L"ему подушки поправлять, печально подносить лекарство, вздыхать и думать про себя: "
+    L"когда же черт возьмет тебя. Так думал молодой повеса, летя в пыли на почтовых, "
+    L"всевышней волею Зевеса наследник всех своих родных. Друзья Людмилы и Руслана, "
+    L"с героем моего романа без предисловий, сей же час позвольте познакомить вас. "
+    L"Онегин, добрый мой приятель, родился на брегах Невы, где, может быть, родились вы "
+    L"или блистали, мой читатель. Там некогда гулял и я, но вреден север для меня.";
+
+wstring sampleText(int copies) {
+    wstring text;
+    for (int k = 0; k < copies; ++k)
+        text += SAMPLE_TEXT;
+    return text;
+}
+
+SUITE(KeyLengthTest)
+{
+    TEST(PeriodFound) {
+        wstring cipher = modAlphaCipher(L"ГРОМ").encrypt(sampleText(4));
+        CHECK_EQUAL(4, KeyAnalyzer(cipher).estimateKeyLength(20));
+    }
+
+    TEST(LongPeriodFound) {
+        wstring cipher = modAlphaCipher(L"ЗИМНИЙВЕЧЕР").encrypt(sampleText(8));
+        CHECK_EQUAL(11, KeyAnalyzer(cipher).estimateKeyLength(20));
+    }
+
+    TEST(CoincidenceIndexOfPlainText) {
+        wstring cipher = modAlphaCipher(L"Б").encrypt(sampleText(1));
+        vector<double> ioc = KeyAnalyzer(cipher).coincidenceIndex(3);
+        CHECK_EQUAL(4u, ioc.size());
+        CHECK(ioc[1] > 0.045);
+    }
+
+    TEST(KasiskiPrefersPeriodMultiples) {
+        wstring cipher = modAlphaCipher(L"ГРОМ").encrypt(sampleText(3));
+        vector<size_t> factors = KeyAnalyzer(cipher).kasiskiFactors(8);
+        CHECK(factors[4] > factors[3]);
+        CHECK(factors[4] > factors[5]);
+        CHECK(factors[2] >= factors[4]);
+    }
+
+    TEST(KasiskiMatchesNaiveCount) {
+        wstring cipher;
+        uint32_t seed = 12345;
+        for (int i = 0; i < 200000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            cipher.push_back(modAlphaCipher::alphabet[(seed >> 16) % 8]);
+        }
+        vector<size_t> factors = KeyAnalyzer(cipher).kasiskiFactors(10, 6);
+        vector<size_t> expected(11, 0);
+        map<wstring, size_t> last;
+        for (size_t i = 0; i + 6 <= cipher.size(); ++i) {
+            auto it = last.find(cipher.substr(i, 6));
+            if (it != last.end()) {
+                for (size_t p = 1; p <= 10; ++p)
+                    expected[p] += (i - it->second) % p == 0;
+                it->second = i;
+            } else {
+                last.emplace(cipher.substr(i, 6), i);
+            }
+        }
+        for (int p = 1; p <= 10; ++p)
+            CHECK_EQUAL(expected[p], factors[p]);
+    }
+
+    TEST(CoincidenceIndexMatchesNaiveCount) {
+        wstring cipher = modAlphaCipher(L"ГРОМ").encrypt(sampleText(300));
+        vector<double> ioc = KeyAnalyzer(cipher).coincidenceIndex(7);
+        for (size_t p = 1; p <= 7; ++p) {
+            double sum = 0;
+            for (size_t c = 0; c < p; ++c) {
+                map<wchar_t, double> freq;
+                double total = 0;
+                for (size_t i = c; i < cipher.size(); i += p, ++total)
+                    freq[cipher[i]]++;
+                double pairs = 0;
+                for (const auto& f : freq)
+                    pairs += f.second * (f.second - 1);
+                sum += pairs / (total * (total - 1));
+            }
+            CHECK_CLOSE(sum / p, ioc[p], 1e-12);
+        }
+    }
+
+    TEST(KasiskiOnMultiMegabyteText) {
+        // 4M различных 12-грамм переполняют таблицу n-грамм; недавний повтор засчитывается
+        wstring cipher;
+        uint32_t seed = 777;
+        for (int i = 0; i < 4000000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            cipher.push_back(modAlphaCipher::alphabet[(seed >> 16) % 33]);
+        }
+        cipher += cipher.substr(cipher.size() - 3000, 200);
+        vector<size_t> factors = KeyAnalyzer(cipher).kasiskiFactors(10, 12);
+        for (size_t p = 1; p <= 10; ++p)
+            CHECK_EQUAL(3000 % p == 0 ? 189u : 0u, factors[p]);
+    }
+
+    TEST(PeriodOnMultiMegabyteText) {
+        wstring cipher = modAlphaCipher(L"ЗИМНИЙВЕЧЕР").encrypt(sampleText(5000));
+        KeyAnalyzer an(cipher);
+        CHECK_EQUAL(11, an.estimateKeyLength(20));
+        CHECK_EQUAL(size_t(KeyAnalyzer::MAX_PERIOD + 1), an.coincidenceIndex(KeyAnalyzer::MAX_PERIOD).size());
+        CHECK_THROW(an.coincidenceIndex(KeyAnalyzer::MAX_PERIOD + 1), cipher_error);
+        CHECK_THROW(an.kasiskiFactors(KeyAnalyzer::MAX_PERIOD + 1), cipher_error);
+    }
+
+    TEST(PeriodLongerThanText) {
+        vector<double> ioc = KeyAnalyzer(L"ГТЁНРС").coincidenceIndex(20);
+        CHECK_EQUAL(21u, ioc.size());
+        CHECK_EQUAL(0.0, ioc[7]);
+    }
+
+    TEST(EmptyCipherText) {
+        CHECK_THROW(KeyAnalyzer an(L""), cipher_error);
+    }
+
+    TEST(InvalidCipherText) {
+        CHECK_THROW(KeyAnalyzer an(L"ГТЁ НРС"), cipher_error);
+    }
+
+    TEST(InvalidPeriod) {
+        KeyAnalyzer an(L"ГТЁНРС");
+        CHECK_THROW(an.coincidenceIndex(0), cipher_error);
+        CHECK_THROW(an.kasiskiFactors(5, 1), cipher_error);
+    }
+}
+
+SUITE(RecoverKeyTest)
+{
+    TEST(KeyRecovered) {
+        wstring cipher = modAlphaCipher(L"ГРОМ").encrypt(sampleText(4));
+        CHECK_WIDE_EQUAL(L"ГРОМ", KeyAnalyzer(cipher).recoverKey(4));
+    }
+
+    TEST(RecoveredKeyDecrypts) {
+        wstring plain = modAlphaCipher(L"Б").decrypt(modAlphaCipher(L"Б").encrypt(sampleText(6)));
+        wstring cipher = modAlphaCipher(L"ЗИМНИЙВЕЧЕР").encrypt(plain);
+        KeyAnalyzer an(cipher);
+        wstring key = an.recoverKey(an.estimateKeyLength(20));
+        CHECK_WIDE_EQUAL(plain, modAlphaCipher(key).decrypt(cipher));
+    }
+
+    TEST(InvalidPeriod) {
+        CHECK_THROW(KeyAnalyzer(L"ГТЁНРС").recoverKey(0), cipher_error);
+    }
+
+    TEST(DegenerateKeyRejected) {
+        // открытый текст без сдвига даёт ключ «А», который modAlphaCipher отвергает
+        wstring plain = modAlphaCipher(L"Б").decrypt(modAlphaCipher(L"Б").encrypt(sampleText(4)));
+        KeyAnalyzer an(plain);
+        CHECK_THROW(an.recoverKey(1), cipher_error);
+        CHECK_THROW(an.recoverKey(4), cipher_error);
+        wstring cipher = modAlphaCipher(L"ГАМА").encrypt(sampleText(4));
+        CHECK_WIDE_EQUAL(L"ГАМА", KeyAnalyzer(cipher).recoverKey(4));
+    }
+
+    TEST(PeriodLongerThanText) {
+        KeyAnalyzer an(L"ГТЁНРС");
+        CHECK_THROW(an.recoverKey(7), cipher_error);
+        CHECK_EQUAL(6u, an.recoverKey(6).size());
+    }
+}
+
+int main()
+{
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,48 @@
+/** @file lmbuild.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Программа построения файла языковой модели
+ * @details Обучает LangModel по текстовому корпусу в кодировке UTF-8
+ * и сохраняет её в двоичный файл для последующей загрузки LangModel::load.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <locale>
+#include <codecvt>
+#include "langModel.h"
+
+using namespace std;
+
+/** @brief Точка входа в программу
+ * @param argc Число аргументов
+ * @param argv Аргументы: путь к корпусу и путь к файлу модели
+ * @return 0 при успехе, 1 при ошибке
+ */
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        cerr << "Использование: " << argv[0] << " <корпус.txt> <модель.bin>" << endl;
+        return 1;
+    }
+
+    ifstream in(argv[1], ios::binary);
+    if (!in) {
+        cerr << "Ошибка: не удалось открыть " << argv[1] << endl;
+        return 1;
+    }
+    stringstream buf;
+    buf << in.rdbuf();
+
+    try {
+        wstring_convert<codecvt_utf8<wchar_t>> conv;
+        LangModel lm(conv.from_bytes(buf.str()));
+        lm.save(argv[2]);
+        cout << "Модель сохранена: " << argv[2] << endl;
+    } catch (const exception& e) {
+        cerr << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
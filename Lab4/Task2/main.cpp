@@ -7,33 +7,13 @@
  * и расшифровки текста методом маршрутной перестановки.
  */
 #include <iostream>
-#include <locale>
-#include <codecvt>
+#include <clocale>
 #include <limits>
+#include <string>
 #include "table.h"
 
 using namespace std;
 
-/** @brief Преобразует строку UTF-8 в wstring
- * @param s Строка в кодировке UTF-8
- * @return Широкая строка
- */
-wstring str8_to_w(const string& s)
-{
-    wstring_convert<codecvt_utf8<wchar_t>> conv;
-    return conv.from_bytes(s);
-}
-
-/** @brief Преобразует wstring в строку UTF-8
- * @param ws Широкая строка
- * @return Строка в кодировке UTF-8
- */
-string w_to_str8(const wstring& ws)
-{
-    wstring_convert<codecvt_utf8<wchar_t>> conv;
-    return conv.to_bytes(ws);
-}
-
 /** @brief Точка входа в программу
  * @return 0 при успехе, 1 при ошибке инициализации
  */
@@ -67,11 +47,11 @@ int main()
 
                 try {
                     if (action == 1) {
-                        wstring enc = cipher.encrypt(str8_to_w(msgLine));
-                        cout << "Зашифровано: " << w_to_str8(enc) << endl;
+                        string enc = cipher.encryptUtf8(msgLine);
+                        cout << "Зашифровано: " << enc << endl;
                     } else {
-                        wstring dec = cipher.decrypt(str8_to_w(msgLine));
-                        cout << "Расшифровано: " << w_to_str8(dec) << endl;
+                        string dec = cipher.decryptUtf8(msgLine);
+                        cout << "Расшифровано: " << dec << endl;
                     }
                 } catch (const cipher_error& e) {
                     cerr << "Ошибка: " << e.what() << endl;
@@ -0,0 +1,89 @@
+/** @file tableAnalysis.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Реализация класса ColumnSearch
+ */
+#include "tableAnalysis.h"
+#include <thread>
+#include <algorithm>
+using namespace std;
+
+namespace {
+
+/** @brief Длины префиксов на этапах отбора кандидатов */
+const size_t STAGE_LENGTHS[] = {64, 256, 1024, 4096};
+/** @brief Минимальное число кандидатов, переходящих на следующий этап */
+const size_t MIN_SURVIVORS = 16;
+
+/** @brief Число рабочих потоков для заданного числа независимых задач */
+unsigned workerCount(size_t tasks)
+{
+    unsigned hw = thread::hardware_concurrency();
+    if (hw == 0)
+        hw = 1;
+    return static_cast<unsigned>(min<size_t>(hw, max<size_t>(tasks, 1)));
+}
+
+} // namespace
+
+ColumnSearch::ColumnSearch(const wstring& cipher, const LangModel& lm):
+    nums(LangModel::toNums(cipher)), model(lm)
+{
+}
+
+double ColumnSearch::prefixScore(int cols, size_t len) const
+{
+    const size_t n = nums.size();
+    double sum = 0;
+    int prev = nums[Table::cipherPos(0, n, cols)];
+    for (size_t i = 1; i < len; ++i) {
+        int cur = nums[Table::cipherPos(i, n, cols)];
+        sum += model.pairScore(prev, cur);
+        prev = cur;
+    }
+    return sum;
+}
+
+/** @brief Поэтапный отбор: на каждом этапе префикс удлиняется, а число кандидатов сокращается */
+vector<ColumnCandidate> ColumnSearch::rank(size_t count) const
+{
+    const size_t n = nums.size();
+    int maxCols = static_cast<int>(max<size_t>(n, 2));
+    vector<ColumnCandidate> alive;
+    alive.reserve(maxCols - 1);
+    for (int k = 2; k <= maxCols; ++k)
+        alive.push_back(ColumnCandidate{k, 0});
+
+    for (size_t stage : STAGE_LENGTHS) {
+        size_t len = min(stage, n);
+        unsigned workers = workerCount(alive.size() / 64);
+        vector<thread> pool;
+        for (unsigned t = 0; t < workers; ++t) {
+            pool.emplace_back([&, t] {
+                for (size_t i = t; i < alive.size(); i += workers)
+                    alive[i].score = len > 1 ? prefixScore(alive[i].cols, len) / (len - 1) : 0;
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+
+        stable_sort(alive.begin(), alive.end(), [](const ColumnCandidate& a, const ColumnCandidate& b) {
+            return a.score > b.score;
+        });
+        if (len == n)
+            break;
+        size_t keep = max({count, MIN_SURVIVORS, alive.size() / 8});
+        if (alive.size() > keep)
+            alive.resize(keep);
+    }
+
+    if (alive.size() > count)
+        alive.resize(count);
+    return alive;
+}
+
+int ColumnSearch::findColumns() const
+{
+    return rank(1).front().cols;
+}
@@ -0,0 +1,60 @@
+/** @file tableAnalysis.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Заголовочный файл модуля подбора ключа табличного шифра
+ * @details Определяет класс ColumnSearch для перебора числа столбцов
+ * по шифротексту, полученному Table::encrypt.
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "table.h"
+#include "langModel.h"
+
+/** @brief Кандидат числа столбцов с оценкой правдоподобия */
+struct ColumnCandidate {
+    int cols;     ///< число столбцов
+    double score; ///< средний логарифм вероятности пары букв расшифрованного префикса
+};
+
+/** @brief Перебор числа столбцов табличного шифра
+ * @details Для каждого кандидата расшифровывается только префикс текста:
+ * позиция открытого текста сразу отображается в позицию шифротекста (Table::cipherPos)
+ * без построения таблицы.
+ * Кандидаты оцениваются биграммной моделью поэтапно на всё более длинных префиксах,
+ * после каждого этапа остаётся лишь лучшая часть кандидатов.
+ * Кандидаты каждого этапа распределяются по потокам.
+ * @warning Реализация только для русского языка
+ */
+class ColumnSearch
+{
+private:
+    std::vector<unsigned char> nums; ///< шифротекст в виде номеров букв
+    const LangModel& model;          ///< модель для оценки расшифровок
+    /** @brief Оценка префикса расшифровки
+     * @param cols Число столбцов
+     * @param len Длина префикса
+     * @return Сумма логарифмов вероятностей пар букв префикса
+     */
+    double prefixScore(int cols, std::size_t len) const;
+
+public:
+    ColumnSearch() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор
+     * @param cipher Шифротекст, полученный Table::encrypt
+     * @param lm Языковая модель; должна существовать всё время жизни объекта
+     * @throw cipher_error если шифротекст невалидный
+     */
+    ColumnSearch(const std::wstring& cipher, const LangModel& lm);
+    /** @brief Лучшие кандидаты числа столбцов
+     * @param count Количество возвращаемых кандидатов
+     * @return Кандидаты от 2 до длины текста, упорядоченные по убыванию оценки
+     */
+    std::vector<ColumnCandidate> rank(std::size_t count) const;
+    /** @brief Наиболее вероятное число столбцов
+     * @return Число столбцов с наилучшей оценкой
+     */
+    int findColumns() const;
+};
@@ -0,0 +1,151 @@
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <locale>
+#include <codecvt>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include "table.h"
+#include "langModel.h"
+#include "tableAnalysis.h"
+using namespace std;
+
+string wideToUtf8(const wstring& ws) {
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(ws);
+}
+
+#define CHECK_WIDE_EQUAL(expected, actual) \
+    CHECK_EQUAL(wideToUtf8(expected), wideToUtf8(actual))
+
+const wstring SAMPLE_TEXT =
+    L"Мой дядя самых честных правил, когда не в шутку занемог, он уважать себя заставил "
+    L"и лучше выдумать не мог. Его пример другим наука, но, боже мой, какая скука с больным "
+    L"сидеть и день и ночь, не отходя ни шагу прочь. Какое низкое коварство полуживого забавлять, "
+    L"ему подушки поправлять, печально подносить лекарство, вздыхать и думать про себя: "
+    L"когда же черт возьмет тебя. Так думал молодой повеса, летя в пыли на почтовых, "
+    L"всевышней волею Зевеса наследник всех своих родных. Друзья Людмилы и Руслана, "
+    L"с героем моего романа без предисловий, сей же час позвольте познакомить вас. "
+    L"Онегин, добрый мой приятель, родился на брегах Невы, где, может быть, родились вы "
+    L"или блистали, мой читатель. Там некогда гулял и я, но вреден север для меня.";
+
+const wstring OTHER_TEXT =
+    L"Буря мглою небо кроет, вихри снежные крутя; то, как зверь, она завоет, то заплачет, "
+    L"как дитя, то по кровле обветшалой вдруг соломой зашумит, то, как путник запоздалый, "
+    L"к нам в окошко застучит. Наша ветхая лачужка и печальна и темна. Что же ты, моя старушка, "
+    L"приумолкла у окна? Выпьем, добрая подружка бедной юности моей, выпьем с горя; где же кружка? "
+    L"Сердцу будет веселей. Спой мне песню, как синица тихо за морем жила; спой мне песню, "
+    L"как девица за водой поутру шла.";
+
+struct Model_fixture {
+    LangModel lm;
+    Model_fixture(): lm(SAMPLE_TEXT) {}
+};
+
+SUITE(LangModelTest)
+{
+    TEST_FIXTURE(Model_fixture, PlainTextScoresHigher) {
+        vector<unsigned char> plain = LangModel::toNums(Table(2).decrypt(Table(2).encrypt(OTHER_TEXT)));
+        vector<unsigned char> shuffled = LangModel::toNums(Table(7).encrypt(OTHER_TEXT));
+        CHECK(lm.score(plain.data(), plain.size()) > lm.score(shuffled.data(), shuffled.size()));
+    }
+
+    TEST_FIXTURE(Model_fixture, TrigramTermsMatchTable) {
+        vector<unsigned char> text = LangModel::toNums(Table(3).encrypt(OTHER_TEXT));
+        vector<float> terms(text.size() - 2);
+        lm.trigramTerms(text.data(), text.size(), terms.data());
+        for (size_t i = 0; i < terms.size(); ++i)
+            CHECK_EQUAL(lm.tripleScore(text[i], text[i + 1], text[i + 2]), terms[i]);
+    }
+
+    TEST_FIXTURE(Model_fixture, WindowScores) {
+        vector<unsigned char> text = LangModel::toNums(Table(4).encrypt(OTHER_TEXT));
+        vector<double> win = lm.windowScores(text.data(), text.size(), 20);
+        CHECK_EQUAL(text.size() - 19, win.size());
+        for (size_t i = 0; i < win.size(); i += 37)
+            CHECK_CLOSE(lm.trigramScore(text.data() + i, 20), win[i], 1e-3);
+        CHECK(lm.windowScores(text.data(), 10, 20).empty());
+        CHECK_THROW(lm.windowScores(text.data(), text.size(), 2), cipher_error);
+    }
+
+    TEST_FIXTURE(Model_fixture, SaveLoad) {
+        const string path = "test_model.bin";
+        lm.save(path);
+        LangModel loaded = LangModel::load(path);
+        remove(path.c_str());
+        vector<unsigned char> text = LangModel::toNums(Table(2).encrypt(OTHER_TEXT));
+        CHECK_EQUAL(lm.score(text.data(), text.size()), loaded.score(text.data(), text.size()));
+        CHECK_EQUAL(lm.trigramScore(text.data(), text.size()), loaded.trigramScore(text.data(), text.size()));
+    }
+
+    TEST(LoadMissingFile) {
+        CHECK_THROW(LangModel::load("no_such_model.bin"), cipher_error);
+    }
+
+    TEST_FIXTURE(Model_fixture, LoadCorruptFile) {
+        const string path = "test_model_corrupt.bin";
+        lm.save(path);
+        ifstream in(path, ios::binary);
+        string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+        auto loadBytes = [&](const string& data) {
+            ofstream(path, ios::binary).write(data.data(), data.size());
+            return LangModel::load(path);
+        };
+        CHECK_THROW(loadBytes(bytes.substr(0, bytes.size() - 1)), cipher_error);
+        CHECK_THROW(loadBytes(bytes.substr(0, 12 + 100)), cipher_error);
+        CHECK_THROW(loadBytes(bytes + '\0'), cipher_error);
+        string nan = bytes;
+        const float bad = numeric_limits<float>::quiet_NaN();
+        memcpy(&nan[12 + 40 * sizeof(float)], &bad, sizeof(bad));
+        CHECK_THROW(loadBytes(nan), cipher_error);
+        string positive = bytes;
+        const float one = 1.0f;
+        memcpy(&positive[bytes.size() - sizeof(float)], &one, sizeof(one));
+        CHECK_THROW(loadBytes(positive), cipher_error);
+        loadBytes(bytes);
+        remove(path.c_str());
+    }
+
+    TEST(ShortCorpus) {
+        CHECK_THROW(LangModel lm(L"АБ, 1"), cipher_error);
+    }
+}
+
+SUITE(ColumnSearchTest)
+{
+    TEST(CipherPosMatchesEncrypt) {
+        wstring plain = L"ВСЕМПРИВЕТДРУГ";
+        for (int cols = 2; cols <= 16; ++cols) {
+            wstring cipher = Table(cols).encrypt(plain);
+            for (size_t i = 0; i < plain.size(); ++i)
+                CHECK(plain[i] == cipher[Table::cipherPos(i, plain.size(), cols)]);
+        }
+    }
+
+    TEST_FIXTURE(Model_fixture, ColumnsFound) {
+        for (int cols : {2, 3, 7, 19, 60}) {
+            wstring cipher = Table(cols).encrypt(OTHER_TEXT);
+            CHECK_EQUAL(cols, ColumnSearch(cipher, lm).findColumns());
+        }
+    }
+
+    TEST_FIXTURE(Model_fixture, RankOrdered) {
+        vector<ColumnCandidate> best = ColumnSearch(Table(5).encrypt(OTHER_TEXT), lm).rank(3);
+        CHECK_EQUAL(3u, best.size());
+        CHECK_EQUAL(5, best[0].cols);
+        CHECK(best[0].score >= best[1].score);
+    }
+
+    TEST_FIXTURE(Model_fixture, InvalidCipherText) {
+        CHECK_THROW(ColumnSearch cs(L"ЕРЕ СПВ", lm), cipher_error);
+        CHECK_THROW(ColumnSearch cs(L"", lm), cipher_error);
+    }
+}
+
+int main()
+{
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,85 @@
+/** @file compositeCipher.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Реализация класса CompositeCipher
+ */
+#include "compositeCipher.h"
+using namespace std;
+
+int CompositeCipher::getValidCols(int key)
+{
+    static_cast<void>(Table(key)); // бросает cipher_error по правилам ключа Table
+    return key;
+}
+
+size_t CompositeCipher::countOpenLetters(const wstring& s)
+{
+    size_t n = 0;
+    for (auto c : s) {
+        if (rus::letterIndex(c) >= 0)
+            n++;
+    }
+    if (n == 0)
+        throw cipher_error("Пустой открытый текст");
+    return n;
+}
+
+CompositeCipher::CompositeCipher(const wstring& keyStr, int colsKey):
+    keySeq(modAlphaCipher(keyStr).getKey()), cols(getValidCols(colsKey))
+{
+}
+
+/** @brief Зашифровывание: первый проход только считает буквы, второй сдвигает по ключу
+ * и записывает каждую букву сразу в позицию после перестановки, как Table::encryptTo.
+ * Открытый текст читается дважды намеренно: позиции столбцов зависят от числа букв,
+ * а без подсчёта пришлось бы писать буквы в промежуточный буфер и переставлять его ещё раз */
+wstring CompositeCipher::encrypt(const wstring& plain) const
+{
+    const size_t n = countOpenLetters(plain);
+    vector<size_t> starts = Table::columnStarts(n, cols);
+    const size_t width = starts.size();
+
+    wstring out(n, L'\0');
+    size_t row = 0, col = 0, k = 0;
+    for (auto c : plain) {
+        int idx = rus::letterIndex(c);
+        if (idx < 0)
+            continue;
+        out[starts[col] + row] = rus::UPPER[modAlphaCipher::shift<false>(idx, keySeq[k])];
+        if (++k == keySeq.size())
+            k = 0;
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
+
+/** @brief Расшифровывание: буква берётся из позиции до перестановки, проверяется и сдвигается обратно */
+wstring CompositeCipher::decrypt(const wstring& cipher) const
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    const size_t n = cipher.size();
+    vector<size_t> starts = Table::columnStarts(n, cols);
+    const size_t width = starts.size();
+
+    wstring out(n, L'\0');
+    size_t row = 0, col = 0, k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int idx = rus::upperIndex(cipher[starts[col] + row]);
+        if (idx < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        out[i] = rus::UPPER[modAlphaCipher::shift<true>(idx, keySeq[k])];
+        if (++k == keySeq.size())
+            k = 0;
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,61 @@
+/** @file compositeCipher.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Заголовочный файл составного шифра
+ * @details Определяет класс CompositeCipher: шифр Гронсфельда,
+ * за которым следует маршрутная перестановка, выполняемые за один проход.
+ */
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "modAlphaCipher.h"
+#include "table.h"
+
+/** @brief Составной шифр: замена методом Гронсфельда, затем табличная перестановка
+ * @details Результат совпадает с Table(cols).encrypt(modAlphaCipher(key).encrypt(text)),
+ * но промежуточные строка и вектор номеров букв не создаются: открытый текст читается
+ * дважды — подсчёт букв, затем каждая буква сдвигается по ключу и сразу записывается
+ * в свою позицию после перестановки (Table::columnStarts), результат пишется один раз. Расшифровывание выполняет обратные операции тем же способом.
+ * @warning Реализация только для русского языка
+ */
+class CompositeCipher
+{
+private:
+    std::vector<int> keySeq; ///< ключ замены в числовом виде
+    int cols;                ///< количество столбцов таблицы (ключ перестановки)
+    /** @brief Валидация ключа перестановки по правилам Table
+     * @param key Количество столбцов
+     * @return Валидный ключ
+     * @throw cipher_error если Table(key) отвергает ключ
+     */
+    static int getValidCols(int key);
+    /** @brief Валидация открытого текста с подсчётом букв
+     * @param [in] s Открытый текст. Не-буквы при шифровании пропускаются
+     * @return Количество букв открытого текста
+     * @throw cipher_error если текст пустой после очистки
+     */
+    static std::size_t countOpenLetters(const std::wstring& s);
+
+public:
+    CompositeCipher() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор для установки ключей
+     * @param keyStr Ключ замены (как для modAlphaCipher)
+     * @param colsKey Количество столбцов (как для Table)
+     * @throw cipher_error если один из ключей невалидный
+     */
+    CompositeCipher(const std::wstring& keyStr, int colsKey);
+    /** @brief Зашифровывание
+     * @param [in] plain Открытый текст
+     * @return Зашифрованная строка
+     * @throw cipher_error если текст пустой после очистки
+     */
+    std::wstring encrypt(const std::wstring& plain) const;
+    /** @brief Расшифровывание
+     * @param [in] cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throw cipher_error если шифротекст невалидный
+     */
+    std::wstring decrypt(const std::wstring& cipher) const;
+};
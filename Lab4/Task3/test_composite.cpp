@@ -0,0 +1,73 @@
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <locale>
+#include <codecvt>
+#include "compositeCipher.h"
+using namespace std;
+
+string wideToUtf8(const wstring& ws) {
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(ws);
+}
+
+#define CHECK_WIDE_EQUAL(expected, actual) \
+    CHECK_EQUAL(wideToUtf8(expected), wideToUtf8(actual))
+
+SUITE(KeyTest)
+{
+    TEST(ValidKeys) {
+        CHECK_WIDE_EQUAL(L"ЁСЁТРГГНЙУ", CompositeCipher(L"Б", 3).encrypt(L"ВСЕМПРИВЕТ"));
+    }
+
+    TEST(InvalidSubstitutionKey) {
+        CHECK_THROW(CompositeCipher cp(L"Б1", 3), cipher_error);
+        CHECK_THROW(CompositeCipher cp(L"ААА", 3), cipher_error);
+    }
+
+    TEST(InvalidColumns) {
+        CHECK_THROW(CompositeCipher cp(L"Б", 1), cipher_error);
+        CHECK_THROW(CompositeCipher cp(L"Б", -3), cipher_error);
+    }
+}
+
+SUITE(EncryptTest)
+{
+    TEST(MatchesChainedCiphers) {
+        CHECK_WIDE_EQUAL(L"ЗУЙЫНОЦТТХЧЭСЯХБТЪЁЦТГАЩП",
+                         CompositeCipher(L"ГРОМ", 5).encrypt(L"Привет, друг! С Новым 2025 Годом, Ёжик"));
+    }
+
+    TEST(KeyLargerThanText) {
+        CHECK_WIDE_EQUAL(L"ЩЩЪЯВФЧХАУФХЬКЯАЦЗЩННШЦЗБЗФЕЁДХЖЖРЫР",
+                         CompositeCipher(L"ЯБЛОКО", 40).encrypt(L"Съешь же ещё этих мягких французских булок"));
+    }
+
+    TEST(NoLetters) {
+        CHECK_THROW(CompositeCipher(L"Б", 3).encrypt(L"1234+5678"), cipher_error);
+    }
+}
+
+SUITE(DecryptTest)
+{
+    TEST(ValidKeys) {
+        CHECK_WIDE_EQUAL(L"ВСЕМПРИВЕТ", CompositeCipher(L"Б", 3).decrypt(L"ЁСЁТРГГНЙУ"));
+    }
+
+    TEST(RoundTrip) {
+        CompositeCipher cp(L"ЗИМНИЙВЕЧЕР", 7);
+        wstring plain = L"СЪЕШЬЖЕЕЩЁЭТИХМЯГКИХФРАНЦУЗСКИХБУЛОКДАВЫПЕЙЧАЮ";
+        for (size_t len = 1; len <= plain.size(); ++len)
+            CHECK_WIDE_EQUAL(plain.substr(0, len), cp.decrypt(cp.encrypt(plain.substr(0, len))));
+    }
+
+    TEST(InvalidCipherText) {
+        CHECK_THROW(CompositeCipher(L"Б", 3).decrypt(L""), cipher_error);
+        CHECK_THROW(CompositeCipher(L"Б", 3).decrypt(L"ЁСЁ ТРГ"), cipher_error);
+        CHECK_THROW(CompositeCipher(L"Б", 3).decrypt(L"ёсётрг"), cipher_error);
+    }
+}
+
+int main()
+{
+    return UnitTest::RunAllTests();
+}
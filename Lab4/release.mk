@@ -0,0 +1,54 @@
+# Оптимизированные сборки программ Lab4.
+# Подключается из Makefile задачи после определения CXX, CXXFLAGS, TARGET, SRCS, HEADERS и TRAIN_KEY.
+#
+#   make release        - $(TARGET)-portable (-O3 -flto) и $(TARGET)-native
+#   make portable       - переносимая сборка для любого x86-64
+#   make native         - сборка под текущий процессор (-march=native) с LTO и PGO:
+#                         инструментированная сборка, прогон на ../corpus.txt, пересборка по профилю
+
+RELEASE_FLAGS = -O3 -flto=auto
+NATIVE_FLAGS = $(RELEASE_FLAGS) -march=native
+PGO_DIR = pgo
+CORPUS = ../corpus.txt
+TRAIN_ROUNDS = 20
+TRAIN_INPUT = $(PGO_DIR)/train.in
+
+.PHONY: release portable native pgo-build release-clean
+
+release: portable native
+
+portable: $(TARGET)-portable
+
+native: $(TARGET)-native
+
+$(TARGET)-portable: $(SRCS) $(HEADERS)
+	$(CXX) $(CXXFLAGS) $(RELEASE_FLAGS) -o $@ $(SRCS)
+
+# Входные данные для обучающего прогона: ключ, затем каждая строка корпуса
+# зашифровывается и расшифровывается (строки не из прописных букв проходят путь ошибки).
+$(TRAIN_INPUT): $(CORPUS)
+	mkdir -p $(PGO_DIR)
+	{ echo "$(TRAIN_KEY)"; \
+	  for i in $$(seq $(TRAIN_ROUNDS)); do \
+	    while IFS= read -r line; do printf '1\n%s\n2\n%s\n' "$$line" "$$line"; done < $(CORPUS); \
+	  done; \
+	  echo 0; } > $@
+
+$(TARGET)-native: $(SRCS) $(HEADERS) $(TRAIN_INPUT)
+	rm -f $(PGO_DIR)/*.gcda
+	$(MAKE) --no-print-directory pgo-build PGO_FLAGS="-fprofile-generate -fprofile-update=atomic" PGO_OUT=$(PGO_DIR)/$(TARGET)-instr
+	./$(PGO_DIR)/$(TARGET)-instr < $(TRAIN_INPUT) > /dev/null 2>&1
+	$(MAKE) --no-print-directory pgo-build PGO_FLAGS="-fprofile-use -fprofile-correction" PGO_OUT=$@
+
+# Объектные файлы обеих стадий PGO лежат по одним и тем же путям,
+# чтобы профили $(PGO_DIR)/*.gcda сопоставлялись с ними при пересборке.
+pgo-build:
+	mkdir -p $(PGO_DIR)
+	for src in $(SRCS); do \
+	  obj=$${src##*/}; \
+	  $(CXX) $(CXXFLAGS) $(NATIVE_FLAGS) $(PGO_FLAGS) -c $$src -o $(PGO_DIR)/$${obj%.cpp}.o || exit 1; \
+	done
+	$(CXX) $(CXXFLAGS) $(NATIVE_FLAGS) $(PGO_FLAGS) -o $(PGO_OUT) $(addprefix $(PGO_DIR)/,$(notdir $(SRCS:.cpp=.o)))
+
+release-clean:
+	rm -rf $(PGO_DIR) $(TARGET)-portable $(TARGET)-native
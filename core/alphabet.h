@@ -0,0 +1,183 @@
+/** @file alphabet.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Общие таблицы русского алфавита
+ * @details Алфавит из 33 букв и функции перевода символа в номер буквы,
+ * используемые шифрами и модулями анализа.
+ */
+#pragma once
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+/** @brief Русский алфавит шифров */
+namespace rus {
+
+constexpr int LETTERS = 33; ///< количество букв алфавита
+constexpr wchar_t UPPER[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"; ///< прописные буквы по порядку
+constexpr wchar_t LOWER[] = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя"; ///< строчные буквы по порядку
+
+/** @brief Номер прописной буквы
+ * @param c Символ
+ * @return Номер буквы в UPPER или -1, если c не прописная русская буква
+ */
+constexpr int upperIndex(wchar_t c)
+{
+    if (c >= L'А' && c <= L'Е')
+        return c - L'А';
+    if (c == L'Ё')
+        return 6;
+    if (c >= L'Ж' && c <= L'Я')
+        return c - L'Ж' + 7;
+    return -1;
+}
+
+/** @brief Номер заведомо прописной буквы без ветвлений
+ * @param c Прописная русская буква, например проверенная firstNonUpper
+ * @return Номер буквы в UPPER
+ */
+constexpr int validUpperIndex(wchar_t c)
+{
+    return c == L'Ё' ? 6 : c - L'А' + (c >= L'Ж');
+}
+
+/** @brief Позиция первого символа, не являющегося прописной русской буквой
+ * @details Текст проверяется блоками по 64 символа без ветвлений внутри блока,
+ * поэтому компилятор векторизует проверку; точная позиция ищется только в блоке с ошибкой.
+ * @param s Текст
+ * @return Позиция первого недопустимого символа или s.size(), если все символы допустимы
+ */
+inline std::size_t firstNonUpper(std::wstring_view s)
+{
+    constexpr std::size_t BLOCK = 64;
+    std::size_t i = 0;
+    for (; i + BLOCK <= s.size(); i += BLOCK) {
+        bool bad = false;
+        for (std::size_t j = i; j < i + BLOCK; ++j) {
+            // А..Я — 32 кода подряд, Ё отдельно
+            std::uint32_t c = static_cast<std::uint32_t>(s[j]);
+            bad |= (c - L'А' >= 32u) & (c != L'Ё');
+        }
+        if (bad)
+            break;
+    }
+    for (; i < s.size(); ++i) {
+        if (upperIndex(s[i]) < 0)
+            return i;
+    }
+    return s.size();
+}
+
+/** @brief Номер буквы без учёта регистра
+ * @param c Символ
+ * @return Номер буквы в UPPER или -1, если c не русская буква
+ */
+constexpr int letterIndex(wchar_t c)
+{
+    if (c >= L'а' && c <= L'е')
+        return c - L'а';
+    if (c == L'ё')
+        return 6;
+    if (c >= L'ж' && c <= L'я')
+        return c - L'ж' + 7;
+    return upperIndex(c);
+}
+
+/** @brief Номер буквы по двухбайтовой последовательности UTF-8 без учёта регистра
+ * @details Все русские буквы кодируются в UTF-8 ровно двумя байтами.
+ * @param b0 Первый байт
+ * @param b1 Второй байт
+ * @return Номер буквы в UPPER или -1, если байты не кодируют русскую букву
+ */
+constexpr int utf8LetterIndex(unsigned char b0, unsigned char b1)
+{
+    if (b0 < 0xC2 || b0 > 0xDF || (b1 & 0xC0) != 0x80)
+        return -1;
+    return letterIndex(static_cast<wchar_t>((b0 & 0x1F) << 6 | (b1 & 0x3F)));
+}
+
+/** @brief Номер прописной буквы по двухбайтовой последовательности UTF-8
+ * @param b0 Первый байт
+ * @param b1 Второй байт
+ * @return Номер буквы в UPPER или -1, если байты не кодируют прописную русскую букву
+ */
+constexpr int utf8UpperIndex(unsigned char b0, unsigned char b1)
+{
+    if (b0 < 0xC2 || b0 > 0xDF || (b1 & 0xC0) != 0x80)
+        return -1;
+    return upperIndex(static_cast<wchar_t>((b0 & 0x1F) << 6 | (b1 & 0x3F)));
+}
+
+/** @brief Первый байт UTF-8 прописной буквы
+ * @param idx Номер буквы
+ * @return Первый байт двухбайтовой последовательности
+ */
+constexpr char utf8Lead(int idx)
+{
+    return static_cast<char>(0xC0 | UPPER[idx] >> 6);
+}
+
+/** @brief Второй байт UTF-8 прописной буквы
+ * @param idx Номер буквы
+ * @return Второй байт двухбайтовой последовательности
+ */
+constexpr char utf8Trail(int idx)
+{
+    return static_cast<char>(0x80 | (UPPER[idx] & 0x3F));
+}
+
+/** @brief Первый байт UTF-8 строчной буквы
+ * @param idx Номер буквы
+ * @return Первый байт двухбайтовой последовательности
+ */
+constexpr char utf8LowerLead(int idx)
+{
+    return static_cast<char>(0xC0 | LOWER[idx] >> 6);
+}
+
+/** @brief Второй байт UTF-8 строчной буквы
+ * @param idx Номер буквы
+ * @return Второй байт двухбайтовой последовательности
+ */
+constexpr char utf8LowerTrail(int idx)
+{
+    return static_cast<char>(0x80 | (LOWER[idx] & 0x3F));
+}
+
+/** @brief Длина последовательности UTF-8 по первому байту
+ * @param b Первый байт
+ * @return От 1 до 4; для недопустимого первого байта — 1
+ */
+constexpr int utf8Length(unsigned char b)
+{
+    if (b >= 0xC2 && b <= 0xDF)
+        return 2;
+    if ((b & 0xF0) == 0xE0)
+        return 3;
+    if (b >= 0xF0 && b <= 0xF4)
+        return 4;
+    return 1;
+}
+
+/** @brief Символ текста в UTF-8
+ * @param s Текст
+ * @param i Позиция первого байта символа
+ * @param [out] step Длина символа в байтах; 1 для недопустимой последовательности
+ * @return Номер русской буквы без учёта регистра или -1
+ */
+inline int utf8LetterAt(std::string_view s, std::size_t i, std::size_t& step)
+{
+    const std::size_t len = utf8Length(static_cast<unsigned char>(s[i]));
+    step = 1;
+    if (i + len > s.size())
+        return -1;
+    for (std::size_t k = 1; k < len; ++k) {
+        if ((static_cast<unsigned char>(s[i + k]) & 0xC0) != 0x80)
+            return -1;
+    }
+    step = len;
+    return len == 2 ? utf8LetterIndex(s[i], s[i + 1]) : -1;
+}
+
+} // namespace rus
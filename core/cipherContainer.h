@@ -0,0 +1,298 @@
+/** @file cipherContainer.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Двоичный контейнер шифротекста с индексом блоков
+ * @details Библиотека только из заголовков. Шифротекст хранится упакованным (PackedText)
+ * блоками фиксированной длины; индекс блоков позволяет прочитать и расшифровать
+ * любой диапазон букв, не читая остальной файл. Для шифра Гронсфельда читается
+ * сам диапазон, для табличного — по одному отрезку шифротекста на каждый затронутый столбец.
+ *
+ * Формат файла (порядок байт платформы, как у файла модели lmbuild):
+ * - заголовок: сигнатура "RC33", версия (uint32), тип шифра (uint8), алфавит (uint8),
+ *   резерв (uint16), подсказка ключа (uint32: длина ключа Гронсфельда или число столбцов),
+ *   количество букв (uint64), букв в блоке (uint32), количество блоков (uint32);
+ * - индекс: для каждого блока позиция первой буквы и смещение данных от начала файла (uint64);
+ * - данные: слова PackedText (uint16) блок за блоком.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include "cipher_error.h"
+#include "alphabet.h"
+#include "packedText.h"
+#include "modAlphaCipher.h"
+#include "table.h"
+
+/** @brief Шифр, которым получен текст контейнера */
+enum class CipherType : std::uint8_t {
+    Gronsfeld = 1, ///< modAlphaCipher
+    Table = 2      ///< Table
+};
+
+/** @brief Контейнер шифротекста
+ * @details Запись — статический метод write. Объект открывает файл на чтение,
+ * загружает заголовок и индекс; буквы читаются по запросу только из нужных блоков.
+ * @warning Реализация только для русского языка
+ */
+class CipherContainer
+{
+public:
+    static constexpr std::uint32_t VERSION = 1;       ///< версия формата
+    static constexpr std::uint8_t ALPHABET_RUS33 = 1; ///< идентификатор алфавита rus::UPPER
+    static constexpr std::uint32_t DEFAULT_BLOCK = 1 << 16; ///< букв в блоке по умолчанию
+
+private:
+    /** @brief Запись индекса блоков */
+    struct IndexEntry {
+        std::uint64_t letterOffset; ///< позиция первой буквы блока
+        std::uint64_t byteOffset;   ///< смещение данных блока от начала файла
+    };
+    std::ifstream in;               ///< открытый файл
+    CipherType type;                ///< тип шифра
+    std::uint32_t hint;             ///< подсказка ключа
+    std::uint64_t letters;          ///< количество букв
+    std::uint32_t blockLetters;     ///< букв в блоке
+    std::vector<IndexEntry> index;  ///< индекс блоков
+
+    static constexpr char MAGIC[4] = {'R', 'C', '3', '3'}; ///< сигнатура файла
+    /** @brief Чтение значения из файла
+     * @param value Куда читать
+     */
+    template <class T>
+    void readValue(T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+
+public:
+    CipherContainer() = delete; ///< запрет конструктора без параметров
+    /** @brief Открытие контейнера
+     * @param path Путь к файлу, созданному write
+     * @throw cipher_error если файл не открывается или имеет неверный формат
+     */
+    explicit CipherContainer(const std::string& path);
+    /** @brief Запись контейнера
+     * @param path Путь к файлу
+     * @param cipher Шифротекст из прописных русских букв
+     * @param cipherType Шифр, которым получен текст
+     * @param keyHint Длина ключа Гронсфельда или число столбцов таблицы
+     * @param blockSize Букв в блоке; округляется вверх до кратного трём
+     * @throw cipher_error если шифротекст пустой или невалидный, либо файл не удалось записать
+     */
+    static void write(const std::string& path, std::wstring_view cipher, CipherType cipherType,
+                      std::uint32_t keyHint, std::uint32_t blockSize = DEFAULT_BLOCK);
+    /** @brief Тип шифра
+     * @return Шифр, указанный при записи
+     */
+    CipherType cipherType() const
+    {
+        return type;
+    }
+    /** @brief Подсказка ключа
+     * @return Длина ключа Гронсфельда или число столбцов таблицы
+     */
+    std::uint32_t keyHint() const
+    {
+        return hint;
+    }
+    /** @brief Количество букв шифротекста
+     * @return Длина шифротекста
+     */
+    std::uint64_t size() const
+    {
+        return letters;
+    }
+    /** @brief Количество блоков
+     * @return Число записей индекса
+     */
+    std::size_t blockCount() const
+    {
+        return index.size();
+    }
+    /** @brief Чтение диапазона шифротекста
+     * @param pos Позиция первой буквы
+     * @param count Количество букв
+     * @return Буквы шифротекста [pos, pos + count)
+     * @throw cipher_error если диапазон выходит за текст или данные повреждены
+     */
+    std::wstring read(std::uint64_t pos, std::size_t count);
+    /** @brief Расшифровывание диапазона шифром Гронсфельда
+     * @param cipher Шифр с ключом, которым получен текст
+     * @param pos Позиция первой буквы
+     * @param count Количество букв
+     * @return Открытый текст [pos, pos + count)
+     * @throw cipher_error если контейнер другого шифра, длина ключа не совпадает
+     * с подсказкой или диапазон пустой либо выходит за текст
+     */
+    std::wstring decrypt(const modAlphaCipher& cipher, std::uint64_t pos, std::size_t count);
+    /** @brief Расшифровывание диапазона открытого текста табличным шифром
+     * @param cipher Шифр с ключом, которым получен текст
+     * @param pos Позиция первой буквы в открытом тексте
+     * @param count Количество букв
+     * @return Открытый текст [pos, pos + count)
+     * @throw cipher_error если контейнер другого шифра, число столбцов не совпадает
+     * с подсказкой или диапазон пустой либо выходит за текст
+     */
+    std::wstring decrypt(const Table& cipher, std::uint64_t pos, std::size_t count);
+};
+
+inline CipherContainer::CipherContainer(const std::string& path):
+    in(path, std::ios::binary)
+{
+    if (!in)
+        throw cipher_error("Не удалось открыть файл контейнера");
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint8_t cipherId = 0, alphabetId = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t blocks = 0;
+    in.read(magic, sizeof(magic));
+    readValue(version);
+    readValue(cipherId);
+    readValue(alphabetId);
+    readValue(reserved);
+    readValue(hint);
+    readValue(letters);
+    readValue(blockLetters);
+    readValue(blocks);
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION
+            || alphabetId != ALPHABET_RUS33
+            || (cipherId != static_cast<std::uint8_t>(CipherType::Gronsfeld)
+                && cipherId != static_cast<std::uint8_t>(CipherType::Table))
+            || blockLetters == 0 || blockLetters % PackedText::PER_WORD != 0
+            || blocks != (letters + blockLetters - 1) / blockLetters)
+        throw cipher_error("Неверный формат файла контейнера");
+    type = static_cast<CipherType>(cipherId);
+
+    index.resize(blocks);
+    for (std::size_t b = 0; b < index.size(); ++b) {
+        readValue(index[b].letterOffset);
+        readValue(index[b].byteOffset);
+        if (index[b].letterOffset != std::uint64_t(b) * blockLetters)
+            throw cipher_error("Неверный формат файла контейнера");
+    }
+    if (!in)
+        throw cipher_error("Неверный формат файла контейнера");
+}
+
+inline void CipherContainer::write(const std::string& path, std::wstring_view cipher, CipherType cipherType,
+                                   std::uint32_t keyHint, std::uint32_t blockSize)
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+    for (auto c : cipher) {
+        if (rus::upperIndex(c) < 0)
+            throw cipher_error("Недопустимый шифротекст");
+    }
+    std::uint32_t block = std::max<std::uint32_t>(blockSize, 1);
+    block += (PackedText::PER_WORD - block % PackedText::PER_WORD) % PackedText::PER_WORD;
+    const std::uint64_t n = cipher.size();
+    const std::uint32_t blocks = static_cast<std::uint32_t>((n + block - 1) / block);
+
+    std::ofstream out(path, std::ios::binary);
+    auto put = [&out](const auto& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    out.write(MAGIC, sizeof(MAGIC));
+    put(VERSION);
+    put(static_cast<std::uint8_t>(cipherType));
+    put(ALPHABET_RUS33);
+    put(std::uint16_t(0));
+    put(keyHint);
+    put(n);
+    put(block);
+    put(blocks);
+
+    const std::uint64_t dataStart = sizeof(MAGIC) + 4 + 1 + 1 + 2 + 4 + 8 + 4 + 4
+                                    + std::uint64_t(blocks) * 2 * sizeof(std::uint64_t);
+    const std::uint64_t wordsPerBlock = block / PackedText::PER_WORD;
+    for (std::uint64_t b = 0; b < blocks; ++b) {
+        put(b * block);
+        put(dataStart + b * wordsPerBlock * sizeof(std::uint16_t));
+    }
+    for (std::uint64_t b = 0; b < blocks; ++b) {
+        std::size_t first = static_cast<std::size_t>(b * block);
+        PackedText packed = PackedText::fromText(cipher.substr(first, block));
+        out.write(reinterpret_cast<const char*>(packed.data().data()),
+                  packed.data().size() * sizeof(std::uint16_t));
+    }
+    if (!out)
+        throw cipher_error("Не удалось записать файл контейнера");
+}
+
+/** @brief Читаются только слова блоков, пересекающих диапазон */
+inline std::wstring CipherContainer::read(std::uint64_t pos, std::size_t count)
+{
+    if (pos > letters || count > letters - pos)
+        throw cipher_error("Диапазон вне шифротекста");
+
+    std::wstring out;
+    out.reserve(count);
+    std::vector<std::uint16_t> words;
+    const std::uint64_t end = pos + count;
+    for (std::size_t b = static_cast<std::size_t>(pos / blockLetters); out.size() < count; ++b) {
+        const IndexEntry& e = index[b];
+        const std::uint64_t from = std::max(pos, e.letterOffset) - e.letterOffset;
+        const std::uint64_t to = std::min<std::uint64_t>(end, e.letterOffset + blockLetters) - e.letterOffset;
+        const std::uint64_t firstWord = from / PackedText::PER_WORD;
+        const std::uint64_t lastWord = (to + PackedText::PER_WORD - 1) / PackedText::PER_WORD;
+
+        words.resize(static_cast<std::size_t>(lastWord - firstWord));
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(e.byteOffset + firstWord * sizeof(std::uint16_t)));
+        in.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(std::uint16_t));
+        if (!in)
+            throw cipher_error("Неверный формат файла контейнера");
+
+        for (std::uint64_t i = from; i < to; ++i) {
+            std::uint16_t w = words[static_cast<std::size_t>(i / PackedText::PER_WORD - firstWord)];
+            if (w >= PackedText::WORD_LIMIT)
+                throw cipher_error("Неверный формат файла контейнера");
+            out.push_back(rus::UPPER[PackedText::digit(w, i % PackedText::PER_WORD)]);
+        }
+    }
+    return out;
+}
+
+/** @brief Фрагмент расшифровывается с позиции ключа pos % длина ключа */
+inline std::wstring CipherContainer::decrypt(const modAlphaCipher& cipher, std::uint64_t pos, std::size_t count)
+{
+    if (type != CipherType::Gronsfeld)
+        throw cipher_error("Контейнер другого шифра");
+    if (hint != cipher.getKey().size())
+        throw cipher_error("Длина ключа не совпадает с контейнером");
+    return cipher.decryptFragment(read(pos, count), static_cast<std::size_t>(pos % cipher.getKey().size()));
+}
+
+/** @brief Буквы одного столбца из диапазона идут в шифротексте подряд,
+ * поэтому из файла читается min(count, cols) отрезков общей длиной count */
+inline std::wstring CipherContainer::decrypt(const Table& cipher, std::uint64_t pos, std::size_t count)
+{
+    if (type != CipherType::Table)
+        throw cipher_error("Контейнер другого шифра");
+    if (hint != static_cast<std::uint32_t>(cipher.getKey()))
+        throw cipher_error("Число столбцов не совпадает с контейнером");
+    if (count == 0 || pos > letters || count > letters - pos)
+        throw cipher_error("Диапазон вне шифротекста");
+
+    const std::uint64_t width = std::min<std::uint64_t>(hint, letters);
+    std::wstring out(count, L'\0');
+    for (std::uint64_t c = 0; c < std::min<std::uint64_t>(width, count); ++c) {
+        // первая позиция диапазона в столбце (pos + c) % width
+        const std::uint64_t first = pos + c;
+        const std::size_t inColumn = static_cast<std::size_t>((count - c + width - 1) / width);
+        std::wstring run = read(Table::cipherPos(static_cast<std::size_t>(first), static_cast<std::size_t>(letters),
+                                                 static_cast<std::size_t>(width)), inColumn);
+        for (std::size_t k = 0; k < inColumn; ++k)
+            out[static_cast<std::size_t>(c + k * width)] = run[k];
+    }
+    return out;
+}
@@ -0,0 +1,129 @@
+/** @file cipherResult.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Результат шифрования без исключений
+ * @details Библиотека только из заголовков. Вариант std::expected для C++17:
+ * значение либо код ошибки с позицией недопустимого символа. Путь ошибки
+ * не выделяет память: сообщения — строковые литералы, исключение не создаётся.
+ */
+#pragma once
+#include <optional>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include "cipher_error.h"
+
+/** @brief Код ошибки шифрования */
+enum class CipherErrc : std::uint8_t {
+    Ok = 0,            ///< ошибки нет
+    EmptyKey,          ///< пустой ключ
+    InvalidKey,        ///< ключ содержит не-буквы
+    DegenerateKey,     ///< больше половины букв ключа — «А»
+    InvalidColumns,    ///< число столбцов <= 1
+    EmptyOpenText,     ///< в открытом тексте нет букв
+    EmptyCipherText,   ///< пустой шифротекст
+    InvalidCipherText  ///< шифротекст содержит не прописные буквы
+};
+
+/** @brief Ошибка шифрования */
+struct CipherError {
+    CipherErrc code = CipherErrc::Ok; ///< код ошибки
+    std::size_t position = 0;         ///< позиция недопустимого символа; 0 для пустых ключа и текста
+
+    /** @brief Текст ошибки
+     * @return Сообщение, с которым бросается cipher_error
+     */
+    const char* message() const
+    {
+        switch (code) {
+        case CipherErrc::Ok:
+            return "Нет ошибки";
+        case CipherErrc::EmptyKey:
+            return "Пустой ключ";
+        case CipherErrc::InvalidKey:
+            return "Недопустимый ключ";
+        case CipherErrc::DegenerateKey:
+            return "Вырожденный ключ";
+        case CipherErrc::InvalidColumns:
+            return "Недопустимый ключ: должен быть > 1";
+        case CipherErrc::EmptyOpenText:
+            return "Пустой открытый текст";
+        case CipherErrc::EmptyCipherText:
+            return "Пустой шифротекст";
+        case CipherErrc::InvalidCipherText:
+            return "Недопустимый шифротекст";
+        }
+        return "Неизвестная ошибка";
+    }
+};
+
+/** @brief Значение или ошибка
+ * @details Бросающий интерфейс шифров — обёртка: value() бросает cipher_error
+ * с сообщением ошибки.
+ * @tparam T Тип значения
+ */
+template <class T>
+class CipherResult
+{
+private:
+    std::optional<T> val; ///< значение при успехе
+    CipherError err;      ///< ошибка при неудаче
+
+public:
+    /** @brief Успешный результат
+     * @details Перегрузка для rvalue нужна, чтобы return локальной строки
+     * в C++17 перемещал её, а не копировал.
+     * @param v Значение
+     */
+    CipherResult(T&& v): val(std::move(v)) {}
+    /** @brief Успешный результат с копированием
+     * @param v Значение
+     */
+    CipherResult(const T& v): val(v) {}
+    /** @brief Неудачный результат
+     * @param e Ошибка
+     */
+    CipherResult(CipherError e): err(e) {}
+    /** @brief Есть ли значение
+     * @return true при успехе
+     */
+    bool ok() const
+    {
+        return val.has_value();
+    }
+    /** @brief Есть ли значение
+     * @return true при успехе
+     */
+    explicit operator bool() const
+    {
+        return ok();
+    }
+    /** @brief Ошибка
+     * @return Код и позиция; code равен CipherErrc::Ok при успехе
+     */
+    const CipherError& error() const
+    {
+        return err;
+    }
+    /** @brief Значение
+     * @return Ссылка на значение
+     * @throw cipher_error если результат неудачный
+     */
+    const T& value() const&
+    {
+        if (!val)
+            throw cipher_error(err.message());
+        return *val;
+    }
+    /** @brief Значение с перемещением
+     * @return Значение
+     * @throw cipher_error если результат неудачный
+     */
+    T value() &&
+    {
+        if (!val)
+            throw cipher_error(err.message());
+        return std::move(*val);
+    }
+};
@@ -0,0 +1,27 @@
+/** @file cipher_error.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Класс исключений, общий для всех шифров
+ */
+#pragma once
+#include <string>
+#include <stdexcept>
+
+/** @brief Класс исключений для ошибок шифрования
+ * @details Наследуется от std::invalid_argument.
+ * Используется для передачи информации об ошибках при работе с шифром.
+ */
+class cipher_error: public std::invalid_argument {
+public:
+    /** @brief Конструктор с параметром типа string
+     * @param what_arg Сообщение об ошибке
+     */
+    explicit cipher_error (const std::string& what_arg):
+        std::invalid_argument(what_arg) {}
+    /** @brief Конструктор с параметром типа const char*
+     * @param what_arg Сообщение об ошибке
+     */
+    explicit cipher_error (const char* what_arg):
+        std::invalid_argument(what_arg) {}
+};
@@ -0,0 +1,70 @@
+/** @file countingResource.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Ресурсы памяти для временных данных шифров
+ * @details Шифры принимают std::pmr::memory_resource, из которого берутся
+ * все временные данные вызова и строка результата. Обычно это
+ * std::pmr::monotonic_buffer_resource, общий для всех вызовов одного запроса.
+ */
+#pragma once
+#include <memory_resource>
+#include <cstddef>
+
+/** @brief Ресурс памяти, считающий выделения
+ * @details Передаёт запросы вышестоящему ресурсу и считает их.
+ * Используется в тестах, чтобы проверить отсутствие выделений в установившемся режиме.
+ */
+class CountingResource: public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource* upstream; ///< вышестоящий ресурс
+    std::size_t allocs = 0;              ///< число выделений
+    std::size_t deallocs = 0;            ///< число освобождений
+    std::size_t bytes = 0;               ///< выделено байт всего
+
+    void* do_allocate(std::size_t size, std::size_t align) override
+    {
+        void* p = upstream->allocate(size, align);
+        allocs++;
+        bytes += size;
+        return p;
+    }
+    void do_deallocate(void* p, std::size_t size, std::size_t align) override
+    {
+        upstream->deallocate(p, size, align);
+        deallocs++;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    /** @brief Конструктор
+     * @param up Вышестоящий ресурс
+     */
+    explicit CountingResource(std::pmr::memory_resource* up = std::pmr::new_delete_resource()):
+        upstream(up) {}
+    /** @brief Число выделений
+     * @return Сколько раз вызывался allocate
+     */
+    std::size_t allocations() const
+    {
+        return allocs;
+    }
+    /** @brief Число освобождений
+     * @return Сколько раз вызывался deallocate
+     */
+    std::size_t deallocations() const
+    {
+        return deallocs;
+    }
+    /** @brief Объём выделенной памяти
+     * @return Выделено байт всего
+     */
+    std::size_t allocatedBytes() const
+    {
+        return bytes;
+    }
+};
@@ -0,0 +1,200 @@
+/** @file decryptView.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Ленивое представление открытого текста поверх шифротекста
+ * @details Библиотека только из заголовков. Буква открытого текста вычисляется
+ * при обращении к ней, поэтому поиск по открытому тексту останавливается на первом
+ * совпадении и не создаёт расшифрованную строку целиком.
+ */
+#pragma once
+#include <string_view>
+#include <iterator>
+#include <cstddef>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+/** @brief Ленивое представление открытого текста
+ * @details Хранит указатель на шифр и шифротекст, ничего не копируя; оба должны
+ * существовать, пока используется представление. Буква i — cipher->decryptAt(text, i).
+ * Итераторы произвольного доступа возвращают буквы по значению и не ссылаются
+ * на само представление; в C++20 тип удовлетворяет std::ranges::random_access_range
+ * и std::ranges::view.
+ * @tparam Cipher Шифр с методом wchar_t decryptAt(std::wstring_view, std::size_t) const
+ */
+template <class Cipher>
+class DecryptView
+#if __cplusplus >= 202002L
+    : public std::ranges::view_base
+#endif
+{
+private:
+    const Cipher* cipher = nullptr; ///< шифр
+    std::wstring_view text;         ///< шифротекст
+
+public:
+    /** @brief Итератор по буквам открытого текста */
+    class iterator
+    {
+    private:
+        const Cipher* cipher = nullptr; ///< шифр
+        std::wstring_view text;         ///< шифротекст
+        std::size_t pos = 0;            ///< позиция в открытом тексте
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag; ///< категория для C++20
+        using iterator_category = std::input_iterator_tag;        ///< ссылка — значение, как у iota_view
+        using value_type = wchar_t;                               ///< тип буквы
+        using difference_type = std::ptrdiff_t;                   ///< разность итераторов
+        using pointer = void;                                     ///< указателя на букву нет
+        using reference = wchar_t;                                ///< буква возвращается по значению
+
+        iterator() = default; ///< итератор без представления
+        /** @brief Итератор на позицию
+         * @param c Шифр
+         * @param t Шифротекст
+         * @param p Позиция
+         */
+        iterator(const Cipher* c, std::wstring_view t, std::size_t p): cipher(c), text(t), pos(p) {}
+        /** @brief Буква открытого текста
+         * @return Расшифрованная буква
+         * @throw cipher_error если символ шифротекста недопустим
+         */
+        wchar_t operator*() const
+        {
+            return cipher->decryptAt(text, pos);
+        }
+        /** @brief Буква со смещением
+         * @param d Смещение
+         * @return Расшифрованная буква
+         */
+        wchar_t operator[](difference_type d) const
+        {
+            return cipher->decryptAt(text, pos + d);
+        }
+        iterator& operator++()
+        {
+            ++pos;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++pos;
+            return old;
+        }
+        iterator& operator--()
+        {
+            --pos;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --pos;
+            return old;
+        }
+        iterator& operator+=(difference_type d)
+        {
+            pos += d;
+            return *this;
+        }
+        iterator& operator-=(difference_type d)
+        {
+            pos -= d;
+            return *this;
+        }
+        friend iterator operator+(iterator it, difference_type d)
+        {
+            return it += d;
+        }
+        friend iterator operator+(difference_type d, iterator it)
+        {
+            return it += d;
+        }
+        friend iterator operator-(iterator it, difference_type d)
+        {
+            return it -= d;
+        }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return static_cast<difference_type>(a.pos) - static_cast<difference_type>(b.pos);
+        }
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.pos == b.pos;
+        }
+        friend bool operator!=(const iterator& a, const iterator& b)
+        {
+            return a.pos != b.pos;
+        }
+        friend bool operator<(const iterator& a, const iterator& b)
+        {
+            return a.pos < b.pos;
+        }
+        friend bool operator>(const iterator& a, const iterator& b)
+        {
+            return a.pos > b.pos;
+        }
+        friend bool operator<=(const iterator& a, const iterator& b)
+        {
+            return a.pos <= b.pos;
+        }
+        friend bool operator>=(const iterator& a, const iterator& b)
+        {
+            return a.pos >= b.pos;
+        }
+    };
+    using const_iterator = iterator; ///< представление только для чтения
+
+    DecryptView() = default; ///< пустое представление
+    /** @brief Представление шифротекста
+     * @param c Шифр
+     * @param cipherText Шифротекст; символы проверяются при обращении к ним
+     */
+    DecryptView(const Cipher& c, std::wstring_view cipherText): cipher(&c), text(cipherText) {}
+    /** @brief Буква открытого текста
+     * @param i Позиция, меньше size()
+     * @return Расшифрованная буква
+     * @throw cipher_error если символ шифротекста недопустим
+     */
+    wchar_t operator[](std::size_t i) const
+    {
+        return cipher->decryptAt(text, i);
+    }
+    /** @brief Начало
+     * @return Итератор на первую букву
+     */
+    iterator begin() const
+    {
+        return iterator(cipher, text, 0);
+    }
+    /** @brief Конец
+     * @return Итератор за последней буквой
+     */
+    iterator end() const
+    {
+        return iterator(cipher, text, text.size());
+    }
+    /** @brief Длина открытого текста
+     * @return Равна длине шифротекста
+     */
+    std::size_t size() const
+    {
+        return text.size();
+    }
+    /** @brief Пустое ли представление
+     * @return true, если шифротекст пустой
+     */
+    bool empty() const
+    {
+        return text.empty();
+    }
+};
+
+#if __cplusplus >= 202002L
+/** @brief Итераторы не ссылаются на представление, поэтому переживают его */
+template <class Cipher>
+inline constexpr bool std::ranges::enable_borrowed_range<DecryptView<Cipher>> = true;
+#endif
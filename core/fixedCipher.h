@@ -0,0 +1,362 @@
+/** @file fixedCipher.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Шифры с ключом, известным при компиляции
+ * @details Библиотека только из заголовков. Ключ задаётся параметром шаблона:
+ * строковые литералы шифруются при компиляции (constexpr),
+ * а в основных циклах для строк период ключа и число столбцов — константы,
+ * поэтому компилятор разворачивает внутренние циклы.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include "cipher_error.h"
+#include "alphabet.h"
+#include "modAlphaCipher.h"
+
+/** @brief Текст фиксированной вместимости, пригодный для вычислений при компиляции
+ * @tparam N Вместимость в символах
+ */
+template <std::size_t N>
+struct FixedText {
+    wchar_t data[N] = {}; ///< символы текста
+    std::size_t size = 0; ///< длина текста
+
+    /** @brief Текст как строковое представление
+     * @return Представление первых size символов
+     */
+    constexpr std::wstring_view view() const
+    {
+        return std::wstring_view(data, size);
+    }
+    /** @brief Копия текста в строке
+     * @return Строка из первых size символов
+     */
+    std::wstring str() const
+    {
+        return std::wstring(data, size);
+    }
+};
+
+/** @brief Проверки ключей шаблонных шифров при компиляции */
+namespace fixedKey {
+
+/** @brief Все элементы ключа — буквы
+ * @param key Номера букв ключа (-1 для не-буквы)
+ * @param n Длина ключа
+ * @return true, если в ключе нет не-букв
+ */
+constexpr bool letters(const int* key, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (key[i] < 0)
+            return false;
+    }
+    return true;
+}
+
+/** @brief Ключ не вырожденный (как в modAlphaCipher)
+ * @param key Номера букв ключа
+ * @param n Длина ключа
+ * @return true, если буква "А" составляет не больше половины ключа
+ */
+constexpr bool nonDegenerate(const int* key, std::size_t n)
+{
+    std::size_t zeroCount = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (key[i] == 0)
+            zeroCount++;
+    }
+    return 2 * zeroCount <= n;
+}
+
+} // namespace fixedKey
+
+/** @brief Шифр Гронсфельда с ключом — параметром шаблона
+ * @details Результаты совпадают с modAlphaCipher с тем же ключом,
+ * например FixedGronsfeld<L'Г', L'Р', L'О', L'М'> и modAlphaCipher(L"ГРОМ").
+ * Невалидный ключ — ошибка компиляции.
+ * Вызов с литералом выполняется при компиляции и возвращает FixedText,
+ * вызов со строкой обрабатывает текст блоками по длине ключа.
+ * @tparam Key Буквы ключа (регистр не важен)
+ * @warning Реализация только для русского языка
+ */
+template <wchar_t... Key>
+class FixedGronsfeld
+{
+public:
+    static constexpr std::size_t PERIOD = sizeof...(Key); ///< длина ключа
+    static_assert(PERIOD > 0, "Пустой ключ");
+
+private:
+    static constexpr int KEY[PERIOD] = {rus::letterIndex(Key)...}; ///< ключ в числовом виде
+    static_assert(fixedKey::letters(KEY, PERIOD), "Недопустимый ключ");
+    static_assert(fixedKey::nonDegenerate(KEY, PERIOD), "Вырожденный ключ");
+
+public:
+    FixedGronsfeld() = delete; ///< все методы статические
+    /** @brief Зашифровывание литерала
+     * @tparam N Размер массива вместе с завершающим нулём
+     * @param [in] plain Открытый текст
+     * @return Зашифрованный текст
+     * @throw cipher_error если текст пустой после очистки (при компиляции — ошибка компиляции)
+     */
+    template <std::size_t N>
+    static constexpr FixedText<N> encrypt(const wchar_t (&plain)[N])
+    {
+        FixedText<N> out;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            int idx = rus::letterIndex(plain[i]);
+            if (idx < 0)
+                continue;
+            out.data[out.size++] = rus::UPPER[modAlphaCipher::shift<false>(idx, KEY[k])];
+            if (++k == PERIOD)
+                k = 0;
+        }
+        if (out.size == 0)
+            throw cipher_error("Пустой открытый текст");
+        return out;
+    }
+    /** @brief Расшифровывание литерала
+     * @tparam N Размер массива вместе с завершающим нулём
+     * @param [in] cipher Шифротекст
+     * @return Расшифрованный текст
+     * @throw cipher_error если шифротекст невалидный
+     */
+    template <std::size_t N>
+    static constexpr FixedText<N> decrypt(const wchar_t (&cipher)[N])
+    {
+        if (N < 2)
+            throw cipher_error("Пустой шифротекст");
+        FixedText<N> out;
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            int idx = rus::upperIndex(cipher[i]);
+            if (idx < 0)
+                throw cipher_error("Недопустимый шифротекст");
+            out.data[out.size++] = rus::UPPER[modAlphaCipher::shift<true>(idx, KEY[i % PERIOD])];
+        }
+        return out;
+    }
+    /** @brief Зашифровывание строки
+     * @details Номера букв сначала собираются в строку результата,
+     * затем сдвигаются полными блоками по PERIOD символов.
+     * @param [in] plain Открытый текст
+     * @return Зашифрованная строка
+     * @throw cipher_error если текст пустой после очистки
+     */
+    static std::wstring encrypt(const std::wstring& plain)
+    {
+        std::wstring out;
+        out.reserve(plain.size());
+        for (auto c : plain) {
+            int idx = rus::letterIndex(c);
+            if (idx >= 0)
+                out.push_back(static_cast<wchar_t>(idx));
+        }
+        if (out.empty())
+            throw cipher_error("Пустой открытый текст");
+        const std::size_t n = out.size();
+        std::size_t i = 0;
+        for (; i + PERIOD <= n; i += PERIOD) {
+            for (std::size_t j = 0; j < PERIOD; ++j)
+                out[i + j] = rus::UPPER[modAlphaCipher::shift<false>(out[i + j], KEY[j])];
+        }
+        for (std::size_t j = 0; i + j < n; ++j)
+            out[i + j] = rus::UPPER[modAlphaCipher::shift<false>(out[i + j], KEY[j])];
+        return out;
+    }
+    /** @brief Расшифровывание строки
+     * @param [in] cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throw cipher_error если шифротекст невалидный
+     */
+    static std::wstring decrypt(const std::wstring& cipher)
+    {
+        if (cipher.empty())
+            throw cipher_error("Пустой шифротекст");
+        const std::size_t n = cipher.size();
+        std::wstring out(n, L'\0');
+        std::size_t i = 0;
+        for (; i + PERIOD <= n; i += PERIOD) {
+            for (std::size_t j = 0; j < PERIOD; ++j) {
+                int idx = rus::upperIndex(cipher[i + j]);
+                if (idx < 0)
+                    throw cipher_error("Недопустимый шифротекст");
+                out[i + j] = rus::UPPER[modAlphaCipher::shift<true>(idx, KEY[j])];
+            }
+        }
+        for (std::size_t j = 0; i + j < n; ++j) {
+            int idx = rus::upperIndex(cipher[i + j]);
+            if (idx < 0)
+                throw cipher_error("Недопустимый шифротекст");
+            out[i + j] = rus::UPPER[modAlphaCipher::shift<true>(idx, KEY[j])];
+        }
+        return out;
+    }
+};
+
+/** @brief Табличный шифр с числом столбцов — параметром шаблона
+ * @details Результаты совпадают с Table(Cols). Вызов с литералом выполняется при компиляции.
+ * Для строк полные строки таблицы переставляются циклом по Cols столбцам,
+ * который компилятор разворачивает; последняя неполная строка и открытый текст
+ * с не-буквами обрабатываются общим циклом.
+ * @tparam Cols Количество столбцов, больше 1
+ * @warning Реализация только для русского языка
+ */
+template <int Cols>
+class FixedTable
+{
+    static_assert(Cols > 1, "Недопустимый ключ: должен быть > 1");
+
+private:
+    static constexpr std::size_t COLS = static_cast<std::size_t>(Cols); ///< количество столбцов
+    /** @brief Начала столбцов в шифротексте, как Table::columnStarts
+     * @param n Длина текста, больше 0
+     * @param [out] starts Начала столбцов
+     * @return Ширина таблицы min(Cols, n)
+     */
+    static constexpr std::size_t columnStarts(std::size_t n, std::size_t (&starts)[COLS])
+    {
+        std::size_t width = n < COLS ? n : COLS;
+        std::size_t rows = (n + width - 1) / width;
+        std::size_t fullCols = n % width;
+        if (fullCols == 0)
+            fullCols = width;
+        std::size_t pos = 0;
+        for (std::size_t c = width; c-- > 0;) {
+            starts[c] = pos;
+            pos += (c < fullCols) ? rows : rows - 1;
+        }
+        return width;
+    }
+
+public:
+    FixedTable() = delete; ///< все методы статические
+    /** @brief Зашифровывание литерала
+     * @tparam N Размер массива вместе с завершающим нулём
+     * @param plain Открытый текст
+     * @return Зашифрованный текст
+     * @throws cipher_error если текст пустой после очистки
+     */
+    template <std::size_t N>
+    static constexpr FixedText<N> encrypt(const wchar_t (&plain)[N])
+    {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            if (rus::letterIndex(plain[i]) >= 0)
+                n++;
+        }
+        if (n == 0)
+            throw cipher_error("Пустой открытый текст");
+        std::size_t starts[COLS] = {};
+        const std::size_t width = columnStarts(n, starts);
+        FixedText<N> out;
+        out.size = n;
+        std::size_t row = 0, col = 0;
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            int idx = rus::letterIndex(plain[i]);
+            if (idx < 0)
+                continue;
+            out.data[starts[col] + row] = rus::UPPER[idx];
+            if (++col == width) {
+                col = 0;
+                row++;
+            }
+        }
+        return out;
+    }
+    /** @brief Расшифровывание литерала
+     * @tparam N Размер массива вместе с завершающим нулём
+     * @param cipher Шифротекст
+     * @return Расшифрованный текст
+     * @throws cipher_error если шифротекст невалидный
+     */
+    template <std::size_t N>
+    static constexpr FixedText<N> decrypt(const wchar_t (&cipher)[N])
+    {
+        if (N < 2)
+            throw cipher_error("Пустой шифротекст");
+        const std::size_t n = N - 1;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (rus::upperIndex(cipher[i]) < 0)
+                throw cipher_error("Недопустимый шифротекст");
+        }
+        std::size_t starts[COLS] = {};
+        const std::size_t width = columnStarts(n, starts);
+        FixedText<N> out;
+        out.size = n;
+        for (std::size_t i = 0; i < n; ++i)
+            out.data[i] = cipher[starts[i % width] + i / width];
+        return out;
+    }
+    /** @brief Зашифровывание строки
+     * @param plain Открытый текст
+     * @return Зашифрованная строка
+     * @throws cipher_error если текст пустой после очистки
+     */
+    static std::wstring encrypt(const std::wstring& plain)
+    {
+        std::size_t n = 0;
+        for (auto c : plain) {
+            if (rus::letterIndex(c) >= 0)
+                n++;
+        }
+        if (n == 0)
+            throw cipher_error("Пустой открытый текст");
+        std::size_t starts[COLS] = {};
+        const std::size_t width = columnStarts(n, starts);
+        std::wstring out(n, L'\0');
+
+        std::size_t row = 0, col = 0, i = 0;
+        if (n == plain.size() && width == COLS) {
+            // только буквы: полные строки таблицы развёрнутым циклом
+            for (; i + COLS <= n; i += COLS, ++row) {
+                for (std::size_t c = 0; c < COLS; ++c)
+                    out[starts[c] + row] = rus::UPPER[rus::letterIndex(plain[i + c])];
+            }
+        }
+        for (; i < plain.size(); ++i) {
+            int idx = rus::letterIndex(plain[i]);
+            if (idx < 0)
+                continue;
+            out[starts[col] + row] = rus::UPPER[idx];
+            if (++col == width) {
+                col = 0;
+                row++;
+            }
+        }
+        return out;
+    }
+    /** @brief Расшифровывание строки
+     * @param cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throws cipher_error если шифротекст невалидный
+     */
+    static std::wstring decrypt(const std::wstring& cipher)
+    {
+        if (cipher.empty())
+            throw cipher_error("Пустой шифротекст");
+        for (auto c : cipher) {
+            if (rus::upperIndex(c) < 0)
+                throw cipher_error("Недопустимый шифротекст");
+        }
+        const std::size_t n = cipher.size();
+        std::size_t starts[COLS] = {};
+        const std::size_t width = columnStarts(n, starts);
+        std::wstring out(n, L'\0');
+
+        std::size_t i = 0, row = 0;
+        if (width == COLS) {
+            for (; i + COLS <= n; i += COLS, ++row) {
+                for (std::size_t c = 0; c < COLS; ++c)
+                    out[i + c] = cipher[starts[c] + row];
+            }
+        }
+        for (std::size_t c = 0; i < n; ++i, ++c)
+            out[i] = cipher[starts[c] + row];
+        return out;
+    }
+};
@@ -0,0 +1,182 @@
+/** @file keyCache.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Кэш шифров Гронсфельда по ключу
+ * @details Библиотека только из заголовков. Повторно используемые ключи
+ * обходятся в поиск по хеш-таблице вместо валидации ключа в конструкторе.
+ */
+#pragma once
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include "modAlphaCipher.h"
+
+/** @brief Общий кэш неизменяемых экземпляров modAlphaCipher
+ * @details Ключи приводятся к верхнему регистру, поэтому "гром" и "ГРОМ" дают один экземпляр.
+ * Кэш разбит на сегменты по хешу ключа, у каждого сегмента своя блокировка
+ * чтения-записи: попадания берут её на чтение и идут параллельно,
+ * промах берёт её на запись и меняет таблицу сегмента на месте, без копирования.
+ * Размер ограничен для каждого сегмента; при переполнении сегмента вытесняется ключ,
+ * к которому не обращались с прошлого обхода (алгоритм «часы»).
+ * Стрелка «часов» у каждого сегмента своя и продолжает обход с места прошлого вытеснения.
+ * Экземпляры возвращаются через shared_ptr и остаются действительными после вытеснения.
+ * @warning Реализация только для русского языка
+ */
+class KeyCache
+{
+public:
+    static const std::size_t SHARDS = 16; ///< количество сегментов
+
+private:
+    /** @brief Ячейка «часов» */
+    struct Slot {
+        std::wstring key;                             ///< нормализованный ключ
+        std::shared_ptr<const modAlphaCipher> cipher; ///< экземпляр шифра
+        std::atomic<bool> used{false};                ///< было обращение с прошлого обхода «часов»
+    };
+    /** @brief Сегмент кэша */
+    struct Shard {
+        std::unordered_map<std::wstring, std::size_t> index; ///< ключ -> номер ячейки
+        std::vector<Slot> slots;                             ///< кольцо ячеек, занятые идут подряд с начала
+        std::size_t hand = 0;                                ///< стрелка «часов»
+        mutable std::shared_mutex lock;                      ///< блокировка сегмента
+    };
+    std::vector<Shard> shards;       ///< сегменты
+    std::size_t shardCapacity;       ///< наибольшее число ключей в сегменте
+    std::atomic<std::size_t> hitCount{0};  ///< число найденных в кэше ключей
+    std::atomic<std::size_t> missCount{0}; ///< число созданных экземпляров
+    /** @brief Нормализация ключа
+     * @param keyStr Ключ
+     * @return Ключ в верхнем регистре или пустая строка, если ключ содержит не-буквы
+     */
+    static std::wstring normalize(const std::wstring& keyStr);
+    /** @brief Валидация размера кэша
+     * @param capacity Размер кэша
+     * @return Валидный размер
+     * @throw cipher_error если capacity < SHARDS
+     */
+    static std::size_t getValidCapacity(std::size_t capacity);
+
+public:
+    /** @brief Конструктор
+     * @details Ограничение действует на каждый сегмент: в сегменте не больше
+     * capacity / SHARDS ключей с округлением вверх, поэтому в кэше может оказаться
+     * до SHARDS - 1 ключей сверх capacity. Вытеснение начинается, когда заполнен
+     * сегмент ключа, даже если в других сегментах есть свободные ячейки.
+     * @param capacity Желаемое число ключей в кэше, не меньше SHARDS
+     * @throw cipher_error если capacity < SHARDS
+     */
+    explicit KeyCache(std::size_t capacity = 1024):
+        shards(SHARDS), shardCapacity((getValidCapacity(capacity) + SHARDS - 1) / SHARDS)
+    {
+        for (auto& shard : shards) {
+            shard.slots = std::vector<Slot>(shardCapacity);
+            shard.index.reserve(shardCapacity);
+        }
+    }
+    /** @brief Шифр для ключа
+     * @param keyStr Ключ шифрования в виде строки
+     * @return Общий неизменяемый экземпляр шифра
+     * @throw cipher_error если ключ невалидный; невалидные ключи не кэшируются
+     */
+    std::shared_ptr<const modAlphaCipher> get(const std::wstring& keyStr);
+    /** @brief Количество ключей в кэше
+     * @return Сумма размеров всех сегментов
+     */
+    std::size_t size() const;
+    /** @brief Число обращений, найденных в кэше
+     * @return Количество попаданий
+     */
+    std::size_t hits() const
+    {
+        return hitCount.load(std::memory_order_relaxed);
+    }
+    /** @brief Число обращений, потребовавших создания шифра
+     * @return Количество промахов
+     */
+    std::size_t misses() const
+    {
+        return missCount.load(std::memory_order_relaxed);
+    }
+};
+
+inline std::size_t KeyCache::getValidCapacity(std::size_t capacity)
+{
+    if (capacity < SHARDS)
+        throw cipher_error("Недопустимый размер кэша: должен быть >= 16");
+    return capacity;
+}
+
+inline std::wstring KeyCache::normalize(const std::wstring& keyStr)
+{
+    std::wstring norm;
+    norm.reserve(keyStr.size());
+    for (auto c : keyStr) {
+        int idx = rus::letterIndex(c);
+        if (idx < 0)
+            return std::wstring();
+        norm.push_back(rus::UPPER[idx]);
+    }
+    return norm;
+}
+
+/** @brief Попадание под блокировкой на чтение; при промахе шифр создаётся вне блокировки, затем вставляется под блокировкой на запись */
+inline std::shared_ptr<const modAlphaCipher> KeyCache::get(const std::wstring& keyStr)
+{
+    std::wstring norm = normalize(keyStr);
+    if (norm.empty())
+        return std::make_shared<const modAlphaCipher>(keyStr); // бросает cipher_error
+
+    Shard& shard = shards[std::hash<std::wstring>()(norm) % SHARDS];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        auto it = shard.index.find(norm);
+        if (it != shard.index.end()) {
+            Slot& slot = shard.slots[it->second];
+            slot.used.store(true, std::memory_order_relaxed);
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return slot.cipher;
+        }
+    }
+
+    auto cipher = std::make_shared<const modAlphaCipher>(norm);
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.index.find(norm);
+    if (it != shard.index.end()) {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        return shard.slots[it->second].cipher;
+    }
+    std::size_t victim = shard.index.size();
+    if (victim == shardCapacity) {
+        while (shard.slots[shard.hand].used.exchange(false, std::memory_order_relaxed))
+            shard.hand = (shard.hand + 1) % shardCapacity;
+        victim = shard.hand;
+        shard.hand = (shard.hand + 1) % shardCapacity;
+        shard.index.erase(shard.slots[victim].key);
+    }
+    Slot& slot = shard.slots[victim];
+    slot.key = norm;
+    slot.cipher = cipher;
+    slot.used.store(false, std::memory_order_relaxed); // второй шанс даёт только повторное обращение
+    shard.index.emplace(std::move(norm), victim);
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return cipher;
+}
+
+inline std::size_t KeyCache::size() const
+{
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        total += shard.index.size();
+    }
+    return total;
+}
@@ -0,0 +1,210 @@
+/** @file langModel.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Реализация класса LangModel
+ */
+#include "langModel.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define LANGMODEL_AVX2 1
+#endif
+using namespace std;
+
+namespace {
+
+const char MAGIC[4] = {'L', 'M', '3', '3'}; ///< сигнатура файла модели
+const uint32_t VERSION = 1;                 ///< версия формата файла модели
+
+/** @brief Логарифмы условных вероятностей по счётчикам: каждая строка из LETTERS элементов нормируется */
+vector<float> logRows(const vector<double>& counts, size_t letters)
+{
+    vector<float> result(counts.size());
+    for (size_t row = 0; row < counts.size(); row += letters) {
+        double rowTotal = 0;
+        for (size_t k = 0; k < letters; ++k)
+            rowTotal += counts[row + k];
+        for (size_t k = 0; k < letters; ++k)
+            result[row + k] = static_cast<float>(log(counts[row + k] / rowTotal));
+    }
+    return result;
+}
+
+/** @brief Проверка загруженной таблицы: логарифмы вероятностей конечны и не больше нуля */
+bool validLogs(const vector<float>& table)
+{
+    for (float v : table) {
+        if (!isfinite(v) || v > 0)
+            return false;
+    }
+    return true;
+}
+
+/** @brief Скалярный расчёт оценок триграмм для позиций [begin, end) */
+void trigramTermsScalar(const float* table, const unsigned char* text, size_t begin, size_t end, float* out)
+{
+    const size_t m = LangModel::LETTERS;
+    for (size_t i = begin; i < end; ++i)
+        out[i] = table[(text[i] * m + text[i + 1]) * m + text[i + 2]];
+}
+
+#ifdef LANGMODEL_AVX2
+/** @brief Расчёт оценок триграмм по восемь позиций: индексы собираются из трёх сдвинутых загрузок, значения — gather */
+__attribute__((target("avx2")))
+size_t trigramTermsAvx2(const float* table, const unsigned char* text, size_t count, float* out)
+{
+    const __m256i m = _mm256_set1_epi32(LangModel::LETTERS);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(text + i)));
+        __m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(text + i + 1)));
+        __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(text + i + 2)));
+        __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_add_epi32(_mm256_mullo_epi32(a, m), b), m), c);
+        _mm256_storeu_ps(out + i, _mm256_i32gather_ps(table, idx, 4));
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+vector<unsigned char> LangModel::toNums(const wstring& s)
+{
+    if (s.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    vector<unsigned char> result;
+    result.reserve(s.size());
+    for (auto c : s) {
+        int idx = rus::upperIndex(c);
+        if (idx < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        result.push_back(static_cast<unsigned char>(idx));
+    }
+    return result;
+}
+
+/** @brief Обучение: подсчёт пар и троек соседних букв и сглаживание добавлением единицы */
+LangModel::LangModel(const wstring& corpus)
+{
+    vector<double> pairs(LETTERS * LETTERS, 1.0);
+    vector<double> triples(LETTERS * LETTERS * LETTERS, 1.0);
+    int prev2 = -1;
+    int prev = -1;
+    size_t letters = 0;
+    for (auto c : corpus) {
+        int idx = rus::letterIndex(c);
+        if (idx < 0)
+            continue;
+        if (prev >= 0)
+            pairs[prev * LETTERS + idx] += 1;
+        if (prev2 >= 0)
+            triples[(prev2 * LETTERS + prev) * LETTERS + idx] += 1;
+        prev2 = prev;
+        prev = idx;
+        letters++;
+    }
+    if (letters < 3)
+        throw cipher_error("Недостаточный образец текста");
+
+    bigram = logRows(pairs, LETTERS);
+    trigram = logRows(triples, LETTERS);
+}
+
+LangModel LangModel::load(const string& path)
+{
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw cipher_error("Не удалось открыть файл модели");
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t letters = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&letters), sizeof(letters));
+    if (!in || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION || letters != LETTERS)
+        throw cipher_error("Неверный формат файла модели");
+
+    LangModel lm;
+    lm.bigram.resize(LETTERS * LETTERS);
+    lm.trigram.resize(LETTERS * LETTERS * LETTERS);
+    in.read(reinterpret_cast<char*>(lm.bigram.data()), lm.bigram.size() * sizeof(float));
+    in.read(reinterpret_cast<char*>(lm.trigram.data()), lm.trigram.size() * sizeof(float));
+    if (!in || in.peek() != ifstream::traits_type::eof())
+        throw cipher_error("Неверный размер файла модели");
+    if (!validLogs(lm.bigram) || !validLogs(lm.trigram))
+        throw cipher_error("Повреждённый файл модели");
+    return lm;
+}
+
+void LangModel::save(const string& path) const
+{
+    ofstream out(path, ios::binary);
+    uint32_t letters = LETTERS;
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    out.write(reinterpret_cast<const char*>(&letters), sizeof(letters));
+    out.write(reinterpret_cast<const char*>(bigram.data()), bigram.size() * sizeof(float));
+    out.write(reinterpret_cast<const char*>(trigram.data()), trigram.size() * sizeof(float));
+    if (!out)
+        throw cipher_error("Не удалось записать файл модели");
+}
+
+double LangModel::score(const unsigned char* text, size_t len) const
+{
+    double sum = 0;
+    for (size_t i = 1; i < len; ++i)
+        sum += bigram[text[i - 1] * LETTERS + text[i]];
+    return sum;
+}
+
+double LangModel::trigramScore(const unsigned char* text, size_t len) const
+{
+    double sum = 0;
+    for (size_t i = 2; i < len; ++i)
+        sum += trigram[(text[i - 2] * LETTERS + text[i - 1]) * LETTERS + text[i]];
+    return sum;
+}
+
+void LangModel::trigramTerms(const unsigned char* text, size_t len, float* out) const
+{
+    if (len < 3)
+        return;
+    const size_t count = len - 2;
+    size_t done = 0;
+#ifdef LANGMODEL_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2)
+        done = trigramTermsAvx2(trigram.data(), text, count, out);
+#endif
+    trigramTermsScalar(trigram.data(), text, done, count, out);
+}
+
+/** @brief Скользящее окно: к сумме добавляется входящая тройка и вычитается выходящая */
+vector<double> LangModel::windowScores(const unsigned char* text, size_t len, size_t window) const
+{
+    if (window < 3)
+        throw cipher_error("Недопустимая длина окна: должна быть >= 3");
+    if (len < window)
+        return {};
+
+    vector<float> terms(len - 2);
+    trigramTerms(text, len, terms.data());
+
+    const size_t inWindow = window - 2;
+    vector<double> result(len - window + 1);
+    double sum = 0;
+    for (size_t i = 0; i < inWindow; ++i)
+        sum += terms[i];
+    result[0] = sum;
+    for (size_t i = 1; i < result.size(); ++i) {
+        sum += terms[i + inWindow - 1] - terms[i - 1];
+        result[i] = sum;
+    }
+    return result;
+}
@@ -0,0 +1,108 @@
+/** @file langModel.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Заголовочный файл языковой модели русского текста
+ * @details Определяет класс LangModel — биграммную и триграммную модель над алфавитом
+ * из 33 прописных русских букв для оценки правдоподобия текста.
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "alphabet.h"
+#include "cipher_error.h"
+
+/** @brief Биграммная и триграммная языковая модель русского текста
+ * @details Модель обучается по образцу текста: считаются частоты пар и троек соседних букв,
+ * из них с аддитивным сглаживанием получаются логарифмы условных вероятностей.
+ * Таблицы хранятся плоскими массивами float[33*33] и float[33*33*33].
+ * Буквы нумеруются по общей таблице rus::UPPER — так же, как в modAlphaCipher::toNums.
+ *
+ * Обученную модель можно сохранить в двоичный файл (программа lmbuild)
+ * и загрузить без повторного обучения.
+ * Формат файла: сигнатура "LM33", версия и число букв (uint32),
+ * затем таблица биграмм и таблица триграмм (float).
+ * @warning Реализация только для русского языка
+ */
+class LangModel
+{
+private:
+    std::vector<float> bigram;  ///< логарифмы вероятностей пар букв, элемент [a * LETTERS + b]
+    std::vector<float> trigram; ///< логарифмы вероятностей троек букв, элемент [(a * LETTERS + b) * LETTERS + c]
+    LangModel() = default; ///< пустая модель для загрузки из файла
+
+public:
+    static const int LETTERS = rus::LETTERS; ///< количество букв алфавита
+    /** @brief Обучение модели по образцу текста
+     * @param corpus Образец текста. Строчные буквы приводятся к прописным, не-буквы пропускаются
+     * @throw cipher_error если в образце меньше трёх букв
+     */
+    explicit LangModel(const std::wstring& corpus);
+    /** @brief Загрузка модели из двоичного файла
+     * @param path Путь к файлу, созданному save
+     * @return Загруженная модель
+     * @throw cipher_error если файл не открывается, имеет неверный формат или размер
+     * либо таблицы содержат не конечные числа или положительные логарифмы вероятностей
+     */
+    static LangModel load(const std::string& path);
+    /** @brief Сохранение модели в двоичный файл
+     * @param path Путь к файлу
+     * @throw cipher_error если файл не удалось записать
+     */
+    void save(const std::string& path) const;
+    /** @brief Перевод шифротекста в номера букв
+     * @param s Текст из прописных русских букв
+     * @return Вектор номеров букв
+     * @throw cipher_error если текст пустой или содержит недопустимые символы
+     */
+    static std::vector<unsigned char> toNums(const std::wstring& s);
+    /** @brief Логарифм вероятности буквы b после буквы a
+     * @param a Номер предыдущей буквы
+     * @param b Номер следующей буквы
+     * @return Логарифм условной вероятности
+     */
+    float pairScore(int a, int b) const
+    {
+        return bigram[a * LETTERS + b];
+    }
+    /** @brief Логарифм вероятности буквы c после пары букв a, b
+     * @param a Номер первой буквы
+     * @param b Номер второй буквы
+     * @param c Номер третьей буквы
+     * @return Логарифм условной вероятности
+     */
+    float tripleScore(int a, int b, int c) const
+    {
+        return trigram[(a * LETTERS + b) * LETTERS + c];
+    }
+    /** @brief Оценка правдоподобия текста по биграммам
+     * @param text Номера букв
+     * @param len Длина текста
+     * @return Сумма логарифмов вероятностей всех пар соседних букв
+     */
+    double score(const unsigned char* text, std::size_t len) const;
+    /** @brief Оценка правдоподобия текста по триграммам
+     * @param text Номера букв
+     * @param len Длина текста
+     * @return Сумма логарифмов вероятностей всех троек соседних букв
+     */
+    double trigramScore(const unsigned char* text, std::size_t len) const;
+    /** @brief Оценки триграмм по позициям
+     * @details На процессорах с AVX2 значения выбираются из таблицы по восемь за раз
+     * инструкцией gather, иначе — скалярным циклом.
+     * @param text Номера букв
+     * @param len Длина текста
+     * @param [out] out Массив из len - 2 элементов; элемент i — оценка тройки, начинающейся в позиции i
+     */
+    void trigramTerms(const unsigned char* text, std::size_t len, float* out) const;
+    /** @brief Оценки скользящего окна
+     * @param text Номера букв
+     * @param len Длина текста
+     * @param window Длина окна в буквах, не меньше 3
+     * @return Вектор из len - window + 1 элементов; элемент i — сумма оценок троек
+     * внутри окна, начинающегося в позиции i. Пустой, если текст короче окна
+     * @throw cipher_error если window < 3
+     */
+    std::vector<double> windowScores(const unsigned char* text, std::size_t len, std::size_t window) const;
+};
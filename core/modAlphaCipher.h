@@ -0,0 +1,542 @@
+/** @file modAlphaCipher.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 17.12.25
+ * @brief Модуль шифрования методом Гронсфельда
+ * @details Библиотека только из заголовков: все методы встраиваемые,
+ * поэтому основные циклы доступны компилятору в каждой единице трансляции.
+ */
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <numeric>
+#include <algorithm>
+#include "cipher_error.h"
+#include "alphabet.h"
+#include "packedText.h"
+#include "decryptView.h"
+#include "cipherResult.h"
+
+/** @brief Шифрование методом Гронсфельда
+ * @details Ключ устанавливается в конструкторе.
+ * Для зашифровывания и расшифровывания предназначены методы encrypt и decrypt.
+ * Они константные и только читают ключ, поэтому один экземпляр можно
+ * использовать из нескольких потоков одновременно без блокировок.
+ * @warning Реализация только для русского языка
+ */
+class modAlphaCipher
+{
+public:
+    inline static const std::wstring alphabet = rus::UPPER; ///< алфавит по порядку, общий для шифра и модулей анализа
+    static constexpr std::size_t FANOUT_BLOCK = 4096; ///< букв в блоке encryptMany
+
+private:
+    std::vector<int> keySeq; ///< ключ в числовом виде
+    /** @brief Преобразование строки в числовой вектор
+     * @param s Строка из прописных русских букв
+     * @return Вектор числовых индексов символов
+     */
+    static std::vector<int> toNums(const std::wstring& s);
+    /** @brief Валидация и нормализация ключа
+     * @param s Входной ключ
+     * @return Валидный ключ в верхнем регистре
+     * @throw cipher_error если ключ пустой, содержит недопустимые символы или вырожденный
+     */
+    static std::wstring getValidKey(const std::wstring& s);
+    /** @brief Проверка ключа без выделения памяти
+     * @param s Входной ключ
+     * @return Ошибка; code равен CipherErrc::Ok для валидного ключа
+     */
+    static CipherError checkKey(std::wstring_view s);
+    /** @brief Зашифровывание в строку заданного типа
+     * @details Проверка, приведение регистра и сдвиг выполняются за один проход;
+     * память выделяется только под результат — распределителем alloc.
+     * @tparam String Тип результата: std::wstring или std::pmr::wstring
+     * @param [in] plain Открытый текст
+     * @param alloc Распределитель памяти результата
+     * @return Зашифрованная строка или ошибка EmptyOpenText; при ошибке память не выделяется
+     */
+    template <class String>
+    CipherResult<String> encryptTo(std::wstring_view plain, const typename String::allocator_type& alloc) const;
+    /** @brief Расшифровывание в строку заданного типа
+     * @tparam String Тип результата: std::wstring или std::pmr::wstring
+     * @param [in] cipher Шифротекст или его фрагмент
+     * @param offset Позиция первого символа cipher в полном шифротексте
+     * @param alloc Распределитель памяти результата
+     * @return Расшифрованная строка или ошибка с позицией в cipher; при ошибке память не выделяется
+     */
+    template <class String>
+    CipherResult<String> decryptTo(std::wstring_view cipher, std::size_t offset, const typename String::allocator_type& alloc) const;
+    /** @brief Сдвиг упакованного текста по ключу
+     * @details Каждое слово распаковывается в три номера букв, они сдвигаются
+     * и сразу упаковываются обратно; текст в wchar_t не создаётся.
+     * @tparam Decrypt Направление сдвига, см. shift
+     * @param text Упакованный текст
+     * @return Упакованный результат той же длины
+     */
+    template <bool Decrypt>
+    PackedText applyPacked(const PackedText& text) const;
+    /** @brief Сдвиг букв текста в UTF-8 с сохранением формата
+     * @tparam Decrypt Направление сдвига, см. shift
+     * @param text Текст в UTF-8
+     * @param [out] letters Количество сдвинутых букв
+     * @return Текст той же длины в байтах
+     */
+    template <bool Decrypt>
+    std::string applyPreserving(std::string_view text, std::size_t& letters) const;
+
+public:
+    modAlphaCipher() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор для установки ключа
+     * @param keyStr Ключ шифрования в виде строки
+     * @throw cipher_error если ключ невалидный
+     */
+    modAlphaCipher(const std::wstring& keyStr);
+    /** @brief Создание шифра без исключений
+     * @param keyStr Ключ шифрования в виде строки
+     * @return Шифр или ошибка ключа с позицией недопустимого символа
+     */
+    static CipherResult<modAlphaCipher> tryCreate(const std::wstring& keyStr);
+    /** @brief Зашифровывание
+     * @param [in] plain Открытый текст
+     * @return Зашифрованная строка
+     * @throw cipher_error если текст пустой после очистки
+     */
+    std::wstring encrypt(const std::wstring& plain) const;
+    /** @brief Расшифровывание
+     * @param [in] cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throw cipher_error если шифротекст невалидный
+     */
+    std::wstring decrypt(const std::wstring& cipher) const;
+    /** @brief Зашифровывание текста в UTF-8 с сохранением формата
+     * @details Буквы сдвигаются на месте внутри исходного текста, регистр каждой
+     * буквы сохраняется, остальные символы (пробелы, знаки препинания, цифры,
+     * недопустимые последовательности) копируются без изменений; ключ продвигается
+     * только на буквах. Русская буква в UTF-8 — всегда два байта, поэтому результат
+     * той же длины и строится за один проход без перевода в wchar_t.
+     * Буквы результата совпадают с encrypt, если привести их к верхнему регистру.
+     * @param plain Открытый текст в UTF-8
+     * @return Шифротекст в UTF-8 с исходным форматом
+     * @throw cipher_error если в тексте нет букв
+     */
+    std::string encryptPreserving(std::string_view plain) const;
+    /** @brief Расшифровывание текста в UTF-8 с сохранением формата
+     * @param cipher Шифротекст, полученный encryptPreserving
+     * @return Открытый текст в UTF-8 с исходным форматом
+     * @throw cipher_error если в шифротексте нет букв
+     */
+    std::string decryptPreserving(std::string_view cipher) const;
+    /** @brief Зашифровывание без исключений
+     * @details Для потоков, где невалидные тексты часты: ошибка возвращается кодом
+     * без исключения и без выделения памяти. encrypt — обёртка над тем же кодом.
+     * @param [in] plain Открытый текст
+     * @return Зашифрованная строка или ошибка EmptyOpenText
+     */
+    CipherResult<std::wstring> tryEncrypt(std::wstring_view plain) const;
+    /** @brief Расшифровывание без исключений
+     * @param [in] cipher Шифротекст
+     * @return Расшифрованная строка или ошибка EmptyCipherText / InvalidCipherText
+     * с позицией первого недопустимого символа
+     */
+    CipherResult<std::wstring> tryDecrypt(std::wstring_view cipher) const;
+    /** @brief Зашифровывание с памятью из заданного ресурса
+     * @details Результат размещается в mr; других выделений памяти нет,
+     * поэтому с монотонным ресурсом (std::pmr::monotonic_buffer_resource) на запрос
+     * вызов не обращается к куче.
+     * @param [in] plain Открытый текст
+     * @param mr Ресурс памяти результата
+     * @return Зашифрованная строка
+     * @throw cipher_error если текст пустой после очистки
+     */
+    std::pmr::wstring encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const;
+    /** @brief Расшифровывание с памятью из заданного ресурса
+     * @param [in] cipher Шифротекст
+     * @param mr Ресурс памяти результата
+     * @return Расшифрованная строка
+     * @throw cipher_error если шифротекст невалидный
+     */
+    std::pmr::wstring decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const;
+    /** @brief Зашифровывание упакованного текста
+     * @param [in] plain Открытый текст, упакованный PackedText
+     * @return Упакованный шифротекст
+     * @throw cipher_error если текст пустой
+     */
+    PackedText encrypt(const PackedText& plain) const;
+    /** @brief Расшифровывание упакованного текста
+     * @param [in] cipher Шифротекст, упакованный PackedText
+     * @return Упакованный открытый текст
+     * @throw cipher_error если шифротекст пустой
+     */
+    PackedText decrypt(const PackedText& cipher) const;
+    /** @brief Расшифровывание фрагмента шифротекста
+     * @details Элемент ключа для символа зависит только от его позиции по модулю длины ключа,
+     * поэтому фрагмент расшифровывается без остального текста.
+     * @param [in] fragment Фрагмент шифротекста
+     * @param offset Позиция начала фрагмента в полном шифротексте
+     * @return Расшифрованный фрагмент
+     * @throw cipher_error если фрагмент пустой или содержит недопустимые символы
+     */
+    std::wstring decryptFragment(std::wstring_view fragment, std::size_t offset) const;
+    /** @brief Расшифровывание одной буквы
+     * @param cipher Шифротекст
+     * @param pos Позиция буквы, меньше cipher.size()
+     * @return Буква открытого текста в позиции pos
+     * @throw cipher_error если символ шифротекста недопустим
+     */
+    wchar_t decryptAt(std::wstring_view cipher, std::size_t pos) const
+    {
+        int idx = rus::upperIndex(cipher[pos]);
+        if (idx < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        return rus::UPPER[shift<true>(idx, keySeq[pos % keySeq.size()])];
+    }
+    /** @brief Ленивое расшифровывание
+     * @details Буквы вычисляются при обращении и проверяются только прочитанные;
+     * строка открытого текста не создаётся. Пустой шифротекст даёт пустое представление.
+     * @param cipher Шифротекст, должен существовать, пока используется представление
+     * @return Представление открытого текста
+     */
+    DecryptView<modAlphaCipher> decryptView(std::wstring_view cipher) const
+    {
+        return DecryptView<modAlphaCipher>(*this, cipher);
+    }
+    /** @brief Зашифровывание одного текста многими ключами
+     * @details Текст проверяется и переводится в номера букв один раз, затем
+     * обрабатывается блоками по FANOUT_BLOCK букв: блок сдвигается всеми ключами,
+     * пока находится в кэше, поэтому открытый текст читается из памяти один раз.
+     * @param ciphers Шифры получателей
+     * @param plain Открытый текст
+     * @return Шифротексты в порядке ciphers; элемент k равен ciphers[k].encrypt(plain)
+     * @throw cipher_error если текст пустой после очистки
+     */
+    static std::vector<std::wstring> encryptMany(const std::vector<modAlphaCipher>& ciphers, std::wstring_view plain);
+    /** @brief Смена ключа шифротекста без расшифровывания
+     * @details Расшифровывание ключом oldKey и зашифровывание ключом newKey вместе —
+     * тоже сдвиг Гронсфельда с периодом НОК длин ключей. Разностный ключ
+     * newKey[i] - oldKey[i] вычисляется заранее (не длиннее текста), затем шифротекст
+     * за один проход переводится в новый шифротекст без промежуточного открытого текста.
+     * @param oldKey Шифр, которым получен cipher
+     * @param newKey Шифр нового ключа
+     * @param cipher Шифротекст
+     * @return Шифротекст того же открытого текста под ключом newKey
+     * @throw cipher_error если шифротекст невалидный
+     */
+    static std::wstring rekey(const modAlphaCipher& oldKey, const modAlphaCipher& newKey, std::wstring_view cipher);
+    /** @brief Ключ в числовом виде
+     * @return Номера букв ключа в алфавите
+     */
+    const std::vector<int>& getKey() const
+    {
+        return keySeq;
+    }
+    /** @brief Сдвиг номера буквы на элемент ключа
+     * @tparam Decrypt true — вычитание (расшифровывание), false — прибавление (зашифровывание)
+     * @param idx Номер буквы
+     * @param k Элемент ключа
+     * @return Номер буквы после сдвига по модулю размера алфавита
+     */
+    template <bool Decrypt>
+    static constexpr int shift(int idx, int k)
+    {
+        return Decrypt ? (idx + rus::LETTERS - k) % rus::LETTERS : (idx + k) % rus::LETTERS;
+    }
+    /** @brief Сдвиг последовательности номеров букв по периодическому ключу
+     * @tparam Decrypt Направление сдвига, см. shift
+     * @tparam It Итератор произвольного доступа на номера букв
+     * @param first Начало последовательности
+     * @param last Конец последовательности
+     * @param key Ключ в числовом виде
+     */
+    template <bool Decrypt, class It>
+    static void applyKey(It first, It last, const std::vector<int>& key)
+    {
+        const std::size_t period = key.size();
+        std::size_t k = 0;
+        for (; first != last; ++first) {
+            *first = shift<Decrypt>(*first, key[k]);
+            if (++k == period)
+                k = 0;
+        }
+    }
+};
+
+inline modAlphaCipher::modAlphaCipher(const std::wstring& keyStr):
+    keySeq(toNums(getValidKey(keyStr)))
+{
+}
+
+inline std::vector<int> modAlphaCipher::toNums(const std::wstring& s)
+{
+    std::vector<int> resultNums;
+    resultNums.reserve(s.size());
+    for (auto sym : s) {
+        resultNums.push_back(rus::upperIndex(sym));
+    }
+    return resultNums;
+}
+
+/** @brief Ключ вырожденный, если больше половины его букв — «А» (нулевой сдвиг) */
+inline CipherError modAlphaCipher::checkKey(std::wstring_view s)
+{
+    if (s.empty())
+        return {CipherErrc::EmptyKey, 0};
+
+    std::size_t zeroCount = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        int idx = rus::letterIndex(s[i]);
+        if (idx < 0)
+            return {CipherErrc::InvalidKey, i};
+        if (idx == 0)
+            zeroCount++;
+    }
+    if (2 * zeroCount > s.size())
+        return {CipherErrc::DegenerateKey, 0};
+    return {};
+}
+
+inline std::wstring modAlphaCipher::getValidKey(const std::wstring& s)
+{
+    CipherError e = checkKey(s);
+    if (e.code != CipherErrc::Ok)
+        throw cipher_error(e.message());
+
+    std::wstring tmp;
+    tmp.reserve(s.size());
+    for (auto c : s)
+        tmp.push_back(rus::UPPER[rus::letterIndex(c)]);
+    return tmp;
+}
+
+inline CipherResult<modAlphaCipher> modAlphaCipher::tryCreate(const std::wstring& keyStr)
+{
+    CipherError e = checkKey(keyStr);
+    if (e.code != CipherErrc::Ok)
+        return e;
+    return modAlphaCipher(keyStr);
+}
+
+/** @brief Не-буквы пропускаются, строчные буквы приводятся к прописным и сразу сдвигаются по ключу;
+ * память резервируется при первой букве, поэтому текст без букв не выделяет память */
+template <class String>
+CipherResult<String> modAlphaCipher::encryptTo(std::wstring_view plain, const typename String::allocator_type& alloc) const
+{
+    String out(alloc);
+    const std::size_t period = keySeq.size();
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < plain.size(); ++i) {
+        int idx = rus::letterIndex(plain[i]);
+        if (idx < 0)
+            continue;
+        if (out.empty())
+            out.reserve(plain.size() - i);
+        out.push_back(rus::UPPER[shift<false>(idx, keySeq[k])]);
+        if (++k == period)
+            k = 0;
+    }
+    if (out.empty())
+        return CipherError{CipherErrc::EmptyOpenText, 0};
+    return out;
+}
+
+/** @brief Шифротекст проверяется до выделения памяти, затем каждый символ сдвигается обратно;
+ * результат той же длины, что и шифротекст */
+template <class String>
+CipherResult<String> modAlphaCipher::decryptTo(std::wstring_view cipher, std::size_t offset, const typename String::allocator_type& alloc) const
+{
+    if (cipher.empty())
+        return CipherError{CipherErrc::EmptyCipherText, 0};
+    const std::size_t bad = rus::firstNonUpper(cipher);
+    if (bad != cipher.size())
+        return CipherError{CipherErrc::InvalidCipherText, bad};
+
+    String out(cipher.size(), L'\0', alloc);
+    const std::size_t period = keySeq.size();
+    std::size_t k = offset % period;
+    for (std::size_t i = 0; i < cipher.size(); ++i) {
+        out[i] = rus::UPPER[shift<true>(rus::validUpperIndex(cipher[i]), keySeq[k])];
+        if (++k == period)
+            k = 0;
+    }
+    return out;
+}
+
+/** @brief Зашифровывание: к каждому символу прибавляется элемент ключа по модулю размера алфавита */
+inline std::wstring modAlphaCipher::encrypt(const std::wstring& plain) const
+{
+    return encryptTo<std::wstring>(plain, {}).value();
+}
+
+/** @brief Расшифровывание: из каждого символа вычитается элемент ключа по модулю размера алфавита */
+inline std::wstring modAlphaCipher::decrypt(const std::wstring& cipher) const
+{
+    return decryptTo<std::wstring>(cipher, 0, {}).value();
+}
+
+inline CipherResult<std::wstring> modAlphaCipher::tryEncrypt(std::wstring_view plain) const
+{
+    return encryptTo<std::wstring>(plain, {});
+}
+
+inline CipherResult<std::wstring> modAlphaCipher::tryDecrypt(std::wstring_view cipher) const
+{
+    return decryptTo<std::wstring>(cipher, 0, {});
+}
+
+inline std::pmr::wstring modAlphaCipher::encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const
+{
+    return encryptTo<std::pmr::wstring>(plain, mr).value();
+}
+
+inline std::pmr::wstring modAlphaCipher::decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const
+{
+    return decryptTo<std::pmr::wstring>(cipher, 0, mr).value();
+}
+
+/** @brief Слово за словом: три номера букв, три элемента ключа подряд, упаковка обратно */
+template <bool Decrypt>
+PackedText modAlphaCipher::applyPacked(const PackedText& text) const
+{
+    PackedText out;
+    out.length = text.length;
+    out.words.resize(text.words.size());
+    const std::size_t period = keySeq.size();
+    const std::size_t full = text.length / PackedText::PER_WORD;
+    std::size_t k = 0;
+    int d[PackedText::PER_WORD];
+    for (std::size_t w = 0; w < out.words.size(); ++w) {
+        const std::size_t count = w < full ? PackedText::PER_WORD : text.length % PackedText::PER_WORD;
+        for (std::size_t j = 0; j < PackedText::PER_WORD; ++j) {
+            d[j] = PackedText::digit(text.words[w], j);
+            if (j < count) {
+                d[j] = shift<Decrypt>(d[j], keySeq[k]);
+                if (++k == period)
+                    k = 0;
+            }
+        }
+        out.words[w] = PackedText::word(d[0], d[1], d[2]);
+    }
+    return out;
+}
+
+inline std::wstring modAlphaCipher::decryptFragment(std::wstring_view fragment, std::size_t offset) const
+{
+    return decryptTo<std::wstring>(fragment, offset, {}).value();
+}
+
+inline PackedText modAlphaCipher::encrypt(const PackedText& plain) const
+{
+    if (plain.empty())
+        throw cipher_error("Пустой открытый текст");
+    return applyPacked<false>(plain);
+}
+
+inline PackedText modAlphaCipher::decrypt(const PackedText& cipher) const
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+    return applyPacked<true>(cipher);
+}
+
+/** @brief Разностный ключ длины min(НОК, n); сдвиг каждой буквы — одно сложение по модулю */
+inline std::wstring modAlphaCipher::rekey(const modAlphaCipher& oldKey, const modAlphaCipher& newKey, std::wstring_view cipher)
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    const std::size_t p1 = oldKey.keySeq.size(), p2 = newKey.keySeq.size();
+    const std::size_t period = std::min(std::lcm(p1, p2), cipher.size());
+    std::vector<int> diff(period);
+    for (std::size_t i = 0; i < period; ++i)
+        diff[i] = shift<true>(newKey.keySeq[i % p2], oldKey.keySeq[i % p1]);
+
+    std::wstring out(cipher.size(), L'\0');
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < cipher.size(); ++i) {
+        int idx = rus::upperIndex(cipher[i]);
+        if (idx < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        out[i] = rus::UPPER[shift<false>(idx, diff[k])];
+        if (++k == period)
+            k = 0;
+    }
+    return out;
+}
+
+/** @brief Номера букв блока используются всеми ключами подряд; позиция ключа каждого шифра переносится между блоками */
+inline std::vector<std::wstring> modAlphaCipher::encryptMany(const std::vector<modAlphaCipher>& ciphers, std::wstring_view plain)
+{
+    std::vector<unsigned char> nums;
+    nums.reserve(plain.size());
+    for (auto c : plain) {
+        int idx = rus::letterIndex(c);
+        if (idx >= 0)
+            nums.push_back(static_cast<unsigned char>(idx));
+    }
+    if (nums.empty())
+        throw cipher_error("Пустой открытый текст");
+
+    std::vector<std::wstring> out(ciphers.size(), std::wstring(nums.size(), L'\0'));
+    std::vector<std::size_t> keyPos(ciphers.size(), 0);
+    for (std::size_t first = 0; first < nums.size(); first += FANOUT_BLOCK) {
+        const std::size_t last = std::min(first + FANOUT_BLOCK, nums.size());
+        for (std::size_t c = 0; c < ciphers.size(); ++c) {
+            const std::vector<int>& key = ciphers[c].keySeq;
+            wchar_t* dst = &out[c][0];
+            std::size_t k = keyPos[c];
+            for (std::size_t i = first; i < last; ++i) {
+                dst[i] = rus::UPPER[shift<false>(nums[i], key[k])];
+                if (++k == key.size())
+                    k = 0;
+            }
+            keyPos[c] = k;
+        }
+    }
+    return out;
+}
+
+/** @brief Не-буквы копируются по байтам, пара байт буквы заменяется парой сдвинутой буквы того же регистра */
+template <bool Decrypt>
+std::string modAlphaCipher::applyPreserving(std::string_view text, std::size_t& letters) const
+{
+    std::string out(text.size(), '\0');
+    const std::size_t period = keySeq.size();
+    std::size_t k = 0, step = 1;
+    letters = 0;
+    for (std::size_t i = 0; i < text.size(); i += step) {
+        int idx = rus::utf8LetterAt(text, i, step);
+        if (idx < 0) {
+            for (std::size_t j = i; j < i + step; ++j)
+                out[j] = text[j];
+            continue;
+        }
+        const bool upper = rus::utf8UpperIndex(text[i], text[i + 1]) >= 0;
+        const int r = shift<Decrypt>(idx, keySeq[k]);
+        out[i] = upper ? rus::utf8Lead(r) : rus::utf8LowerLead(r);
+        out[i + 1] = upper ? rus::utf8Trail(r) : rus::utf8LowerTrail(r);
+        letters++;
+        if (++k == period)
+            k = 0;
+    }
+    return out;
+}
+
+inline std::string modAlphaCipher::encryptPreserving(std::string_view plain) const
+{
+    std::size_t letters = 0;
+    std::string out = applyPreserving<false>(plain, letters);
+    if (letters == 0)
+        throw cipher_error(CipherError{CipherErrc::EmptyOpenText, 0}.message());
+    return out;
+}
+
+inline std::string modAlphaCipher::decryptPreserving(std::string_view cipher) const
+{
+    std::size_t letters = 0;
+    std::string out = applyPreserving<true>(cipher, letters);
+    if (letters == 0)
+        throw cipher_error(CipherError{CipherErrc::EmptyCipherText, 0}.message());
+    return out;
+}
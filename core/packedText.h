@@ -0,0 +1,167 @@
+/** @file packedText.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Упакованное хранение текста из прописных русских букв
+ * @details Библиотека только из заголовков. Три буквы занимают одно 16-битное слово
+ * (33^3 = 35937 < 65536), то есть 5,33 бита на букву вместо 16 бит в UTF-8
+ * и 32 бит в wchar_t.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "cipher_error.h"
+#include "alphabet.h"
+
+/** @brief Текст из прописных русских букв, упакованный по три буквы в слово
+ * @details Слово i хранит буквы 3i, 3i+1, 3i+2 как число a*33*33 + b*33 + c,
+ * где a, b, c — номера букв в rus::UPPER. Недостающие буквы последнего слова равны нулю.
+ * Любую букву можно прочитать по номеру, не распаковывая остальные.
+ * @warning Реализация только для русского языка
+ */
+class PackedText
+{
+public:
+    static constexpr std::size_t PER_WORD = 3; ///< букв в слове
+    static constexpr std::uint16_t WORD_LIMIT = rus::LETTERS * rus::LETTERS * rus::LETTERS; ///< наибольшее значение слова + 1
+
+private:
+    std::vector<std::uint16_t> words; ///< упакованные буквы
+    std::size_t length = 0;           ///< количество букв
+    friend class modAlphaCipher;      ///< читает слова и заполняет слова нового PackedText в applyPacked
+
+public:
+    PackedText() = default; ///< пустой текст
+    /** @brief Упаковка текста
+     * @param text Текст из прописных русских букв
+     * @return Упакованный текст
+     * @throw cipher_error если текст содержит другие символы
+     */
+    static PackedText fromText(std::wstring_view text);
+    /** @brief Восстановление из сохранённых слов
+     * @param data Слова, полученные data()
+     * @param n Количество букв
+     * @return Упакованный текст
+     * @throw cipher_error если число слов не соответствует n, слово вне диапазона
+     * или недостающие буквы последнего слова не равны нулю
+     */
+    static PackedText fromData(std::vector<std::uint16_t> data, std::size_t n);
+    /** @brief Распаковка текста
+     * @return Текст из прописных русских букв
+     */
+    std::wstring toText() const;
+    /** @brief Номер буквы
+     * @param i Позиция буквы, меньше size()
+     * @return Номер буквы в rus::UPPER
+     */
+    int at(std::size_t i) const
+    {
+        return digit(words[i / PER_WORD], i % PER_WORD);
+    }
+    /** @brief Количество букв
+     * @return Длина текста
+     */
+    std::size_t size() const
+    {
+        return length;
+    }
+    /** @brief Пустой ли текст
+     * @return true, если букв нет
+     */
+    bool empty() const
+    {
+        return length == 0;
+    }
+    /** @brief Упакованные слова для сохранения
+     * @return Вектор из ceil(size() / 3) слов
+     */
+    const std::vector<std::uint16_t>& data() const
+    {
+        return words;
+    }
+    /** @brief Сборка слова из трёх номеров букв
+     * @param a Номер первой буквы
+     * @param b Номер второй буквы
+     * @param c Номер третьей буквы
+     * @return Слово
+     */
+    static std::uint16_t word(int a, int b, int c)
+    {
+        return static_cast<std::uint16_t>((a * rus::LETTERS + b) * rus::LETTERS + c);
+    }
+    /** @brief Номер буквы в слове
+     * @param w Слово
+     * @param j Позиция в слове: 0, 1 или 2
+     * @return Номер буквы
+     */
+    static int digit(std::uint16_t w, std::size_t j)
+    {
+        switch (j) {
+        case 0:
+            return w / (rus::LETTERS * rus::LETTERS);
+        case 1:
+            return w / rus::LETTERS % rus::LETTERS;
+        default:
+            return w % rus::LETTERS;
+        }
+    }
+    /** @brief Сравнение текстов
+     * @param o Другой текст
+     * @return true, если буквы совпадают
+     */
+    bool operator==(const PackedText& o) const
+    {
+        return length == o.length && words == o.words;
+    }
+};
+
+inline PackedText PackedText::fromText(std::wstring_view text)
+{
+    PackedText p;
+    p.length = text.size();
+    p.words.resize((text.size() + PER_WORD - 1) / PER_WORD);
+    int d[PER_WORD] = {};
+    for (std::size_t w = 0; w < p.words.size(); ++w) {
+        for (std::size_t j = 0; j < PER_WORD; ++j) {
+            std::size_t i = w * PER_WORD + j;
+            d[j] = i < text.size() ? rus::upperIndex(text[i]) : 0;
+            if (d[j] < 0)
+                throw cipher_error("Недопустимый символ упакованного текста");
+        }
+        p.words[w] = word(d[0], d[1], d[2]);
+    }
+    return p;
+}
+
+inline PackedText PackedText::fromData(std::vector<std::uint16_t> data, std::size_t n)
+{
+    if (data.size() != (n + PER_WORD - 1) / PER_WORD)
+        throw cipher_error("Неверная длина упакованного текста");
+    for (auto w : data) {
+        if (w >= WORD_LIMIT)
+            throw cipher_error("Недопустимое слово упакованного текста");
+    }
+    for (std::size_t i = n; i < data.size() * PER_WORD; ++i) {
+        if (digit(data.back(), i % PER_WORD) != 0)
+            throw cipher_error("Недопустимое слово упакованного текста");
+    }
+    PackedText p;
+    p.words = std::move(data);
+    p.length = n;
+    return p;
+}
+
+inline std::wstring PackedText::toText() const
+{
+    std::wstring out(words.size() * PER_WORD, L'\0');
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        out[w * PER_WORD] = rus::UPPER[digit(words[w], 0)];
+        out[w * PER_WORD + 1] = rus::UPPER[digit(words[w], 1)];
+        out[w * PER_WORD + 2] = rus::UPPER[digit(words[w], 2)];
+    }
+    out.resize(length);
+    return out;
+}
@@ -0,0 +1,625 @@
+/** @file table.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 17.12.25
+ * @brief Модуль табличного шифра маршрутной перестановки
+ * @details Библиотека только из заголовков: все методы встраиваемые.
+ * Текст при шифровании записывается в таблицу по строкам,
+ * а считывается по столбцам справа налево. При расшифровке — обратная операция.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include "cipher_error.h"
+#include "alphabet.h"
+#include "transpose.h"
+#include "decryptView.h"
+#include "cipherResult.h"
+
+/** @brief Шифрование методом маршрутной перестановки (табличный шифр)
+ * @details Текст записывается в таблицу по строкам слева направо,
+ * а считывается по столбцам справа налево. Ключ — количество столбцов.
+ * Методы encrypt и decrypt константные, экземпляр можно разделять между потоками.
+ * @warning Реализация только для русского языка
+ */
+class Table
+{
+private:
+    int cols; ///< количество столбцов в таблице (ключ)
+    /** @brief Валидация ключа
+     * @param key Количество столбцов
+     * @return Валидный ключ
+     * @throws cipher_error если ключ <= 1
+     */
+    static int getValidKey(int key);
+    /** @brief Вектор позиций с тем же распределителем памяти, что у строки String */
+    template <class String>
+    using Positions = std::vector<std::size_t,
+          typename std::allocator_traits<typename String::allocator_type>::template rebind_alloc<std::size_t>>;
+    /** @brief Зашифровывание в строку заданного типа
+     * @details Первый проход считает буквы, второй записывает каждую букву
+     * сразу в её позицию в шифротексте. Память выделяется распределителем alloc
+     * под результат и начала столбцов.
+     * @tparam String Тип результата: std::wstring или std::pmr::wstring
+     * @param plain Открытый текст
+     * @param alloc Распределитель памяти
+     * @return Зашифрованная строка или ошибка EmptyOpenText; при ошибке память не выделяется
+     */
+    template <class String>
+    CipherResult<String> encryptTo(std::wstring_view plain, const typename String::allocator_type& alloc) const;
+    /** @brief Размер буфера на стеке для перестановки на месте, в буквах */
+    static const std::size_t IN_PLACE_BUFFER = 2048;
+    /** @brief Перестановка на месте плитками
+     * @details Буфер на стеке на IN_PLACE_BUFFER букв, если в нём помещается плитка
+     * не ниже 16 строк (cols <= IN_PLACE_BUFFER / 16), иначе буфер на 16 строк
+     * и начала столбцов выделяются в куче: O(cols) памяти вместо O(n) у копирующей перестановки.
+     * @tparam Decrypt false — буква позиции i переносится в позицию P(i),
+     * true — в позицию i переносится буква из P(i); P — позиция в шифротексте
+     * @param [in,out] text Текст из n прописных букв
+     */
+    template <bool Decrypt>
+    void permuteInPlace(std::wstring& text) const;
+    /** @brief Перестановка плитками через заданный буфер
+     * @details Полные строки таблицы делятся на плитки по height строк.
+     * Каждая плитка переставляется через буфер, после чего её столбцы —
+     * непрерывные блоки по height букв; блоки переносятся на свои места обходом циклов
+     * по номерам блоков, а остаток текста короче плитки раскладывается через буфер.
+     * Лидер цикла проверяется повторным обходом, но шаг обхода — одно вычисление
+     * на блок из height >= 16 букв, поэтому проверка дешевле переноса блоков.
+     * @tparam Decrypt См. permuteInPlace
+     * @param [in,out] text Текст из n прописных букв
+     * @param width Число столбцов min(cols, n)
+     * @param height Строк в плитке
+     * @param buf Буфер на min(height * width, n) букв
+     * @param starts Буфер на width позиций
+     */
+    template <bool Decrypt>
+    void permuteTiles(std::wstring& text, std::size_t width, std::size_t height,
+                      wchar_t* buf, std::size_t* starts) const;
+    /** @brief Расшифровывание в строку заданного типа
+     * @tparam String Тип результата: std::wstring или std::pmr::wstring
+     * @param cipher Шифротекст
+     * @param alloc Распределитель памяти
+     * @return Расшифрованная строка или ошибка с позицией в cipher; при ошибке память не выделяется
+     */
+    template <class String>
+    CipherResult<String> decryptTo(std::wstring_view cipher, const typename String::allocator_type& alloc) const;
+
+public:
+    Table() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор для установки ключа
+     * @param key Количество столбцов (ключ шифрования)
+     * @throws cipher_error если ключ невалидный
+     */
+    explicit Table(int key);
+    /** @brief Создание шифра без исключений
+     * @param key Количество столбцов
+     * @return Шифр или ошибка InvalidColumns
+     */
+    static CipherResult<Table> tryCreate(int key);
+    /** @brief Зашифровывание
+     * @param plain Открытый текст
+     * @return Зашифрованная строка
+     * @throws cipher_error если текст невалидный
+     */
+    std::wstring encrypt(const std::wstring& plain) const;
+    /** @brief Расшифровывание
+     * @param cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throws cipher_error если шифротекст невалидный
+     */
+    std::wstring decrypt(const std::wstring& cipher) const;
+    /** @brief Зашифровывание без исключений
+     * @details Ошибка возвращается кодом без исключения и без выделения памяти;
+     * encrypt — обёртка над тем же кодом.
+     * @param plain Открытый текст
+     * @return Зашифрованная строка или ошибка EmptyOpenText
+     */
+    CipherResult<std::wstring> tryEncrypt(std::wstring_view plain) const;
+    /** @brief Расшифровывание без исключений
+     * @param cipher Шифротекст
+     * @return Расшифрованная строка или ошибка EmptyCipherText / InvalidCipherText
+     * с позицией первого недопустимого символа
+     */
+    CipherResult<std::wstring> tryDecrypt(std::wstring_view cipher) const;
+    /** @brief Зашифровывание с памятью из заданного ресурса
+     * @details Результат и временные данные размещаются в mr,
+     * поэтому с монотонным ресурсом на запрос вызов не обращается к куче.
+     * @param plain Открытый текст
+     * @param mr Ресурс памяти
+     * @return Зашифрованная строка
+     * @throws cipher_error если текст невалидный
+     */
+    std::pmr::wstring encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const;
+    /** @brief Расшифровывание с памятью из заданного ресурса
+     * @param cipher Шифротекст
+     * @param mr Ресурс памяти
+     * @return Расшифрованная строка
+     * @throws cipher_error если шифротекст невалидный
+     */
+    std::pmr::wstring decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const;
+    /** @brief Зашифровывание текста в UTF-8
+     * @details Каждая русская буква в UTF-8 занимает ровно два байта, поэтому перестановка
+     * переносит двухбайтовые единицы без перевода текста в wchar_t и обратно.
+     * Строчные буквы заменяются парой байт прописной, остальные символы пропускаются.
+     * @param plain Открытый текст в UTF-8; недопустимые последовательности считаются не-буквами
+     * @return Шифротекст в UTF-8
+     * @throws cipher_error если текст пустой после очистки
+     */
+    std::string encryptUtf8(std::string_view plain) const;
+    /** @brief Расшифровывание текста в UTF-8
+     * @param cipher Шифротекст в UTF-8 из прописных русских букв
+     * @return Открытый текст в UTF-8
+     * @throws cipher_error если шифротекст пустой или содержит недопустимые символы
+     */
+    std::string decryptUtf8(std::string_view cipher) const;
+    /** @brief Зашифровывание на месте
+     * @details Текст нормализуется в той же строке, затем перестановка применяется
+     * обходом её циклов: буква переносится в свою позицию, вытесненная — в свою и так далее.
+     * Полные строки переставляются плитками через буфер, затем столбцы плиток
+     * переносятся на свои места целыми блоками обходом циклов; цикл начинается
+     * с наименьшего своего номера, что проверяется обходом цикла. Дополнительная память —
+     * IN_PLACE_BUFFER букв на стеке при cols <= 128, иначе 16 * cols букв и cols позиций в куче;
+     * копии текста и отметок пройденных позиций нет.
+     * @param [in,out] text Открытый текст; после вызова — шифротекст
+     * @throws cipher_error если текст пустой после очистки; строка при этом не изменяется
+     */
+    void encryptInPlace(std::wstring& text) const;
+    /** @brief Расшифровывание на месте
+     * @param [in,out] text Шифротекст; после вызова — открытый текст
+     * @throws cipher_error если шифротекст невалидный; строка при этом не изменяется
+     */
+    void decryptInPlace(std::wstring& text) const;
+    /** @brief Расшифровывание диапазона открытого текста
+     * @details Позиция открытого текста вычисляется в позицию шифротекста арифметически
+     * (cipherPos), поэтому читаются и проверяются только count букв шифротекста:
+     * время и память O(count) вместо O(n).
+     * @param cipher Весь шифротекст
+     * @param offset Позиция первой буквы в открытом тексте
+     * @param count Количество букв
+     * @return Открытый текст [offset, offset + count)
+     * @throws cipher_error если шифротекст пустой, диапазон выходит за текст
+     * или прочитанные буквы недопустимы
+     */
+    std::wstring decryptRange(std::wstring_view cipher, std::size_t offset, std::size_t count) const;
+    /** @brief Расшифровывание одной буквы
+     * @param cipher Шифротекст
+     * @param pos Позиция в открытом тексте, меньше cipher.size()
+     * @return Буква открытого текста в позиции pos
+     * @throw cipher_error если символ шифротекста недопустим
+     */
+    wchar_t decryptAt(std::wstring_view cipher, std::size_t pos) const
+    {
+        wchar_t c = cipher[cipherPos(pos, cipher.size(), cols)];
+        if (rus::upperIndex(c) < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        return c;
+    }
+    /** @brief Ленивое расшифровывание
+     * @details Буква позиции i читается из позиции cipherPos(i) при обращении;
+     * проверяются только прочитанные буквы. Пустой шифротекст даёт пустое представление.
+     * @param cipher Шифротекст, должен существовать, пока используется представление
+     * @return Представление открытого текста
+     */
+    DecryptView<Table> decryptView(std::wstring_view cipher) const
+    {
+        return DecryptView<Table>(*this, cipher);
+    }
+    /** @brief Получение ключа
+     * @return Количество столбцов
+     */
+    int getKey() const
+    {
+        return cols;
+    }
+    /** @brief Начала столбцов таблицы в шифротексте
+     * @details При cols >= n таблица состоит из одной строки,
+     * поэтому число столбцов ограничивается длиной текста.
+     * @param n Длина текста, больше 0
+     * @param cols Количество столбцов
+     * @return Вектор из min(cols, n) элементов; элемент c — позиция в шифротексте первой буквы столбца c
+     */
+    static std::vector<std::size_t> columnStarts(std::size_t n, std::size_t cols);
+    /** @brief Начала столбцов таблицы в шифротексте в заданный вектор
+     * @tparam Alloc Распределитель памяти вектора
+     * @param n Длина текста, больше 0
+     * @param cols Количество столбцов
+     * @param [out] starts Вектор из min(cols, n) элементов, см. columnStarts(n, cols)
+     */
+    template <class Alloc>
+    static void columnStarts(std::size_t n, std::size_t cols, std::vector<std::size_t, Alloc>& starts);
+    /** @brief Позиция в шифротексте буквы открытого текста
+     * @param pos Позиция в открытом тексте
+     * @param n Длина текста
+     * @param cols Количество столбцов
+     * @return Позиция той же буквы в шифротексте
+     */
+    static std::size_t cipherPos(std::size_t pos, std::size_t n, std::size_t cols);
+};
+
+/** @brief Валидация ключа: должен быть > 1 */
+inline int Table::getValidKey(int key)
+{
+    if (key <= 1)
+        throw cipher_error(CipherError{CipherErrc::InvalidColumns, 0}.message());
+    return key;
+}
+
+inline CipherResult<Table> Table::tryCreate(int key)
+{
+    if (key <= 1)
+        return CipherError{CipherErrc::InvalidColumns, 0};
+    return Table(key);
+}
+
+inline Table::Table(int key):
+    cols(getValidKey(key))
+{
+}
+
+/** @brief Шифрование: буква открытого текста из строки r и столбца c записывается в позицию starts[c] + r;
+ * для текста из одних прописных букв полные строки переставляются ядрами transpose */
+template <class String>
+CipherResult<String> Table::encryptTo(std::wstring_view plain, const typename String::allocator_type& alloc) const
+{
+    std::size_t n = 0, upper = 0;
+    for (auto c : plain) {
+        if (rus::upperIndex(c) >= 0)
+            upper++;
+        else if (rus::letterIndex(c) >= 0)
+            n++;
+    }
+    n += upper;
+    if (n == 0)
+        return CipherError{CipherErrc::EmptyOpenText, 0};
+
+    Positions<String> starts(alloc);
+    columnStarts(n, cols, starts);
+    const std::size_t width = starts.size();
+
+    String out(n, L'\0', alloc);
+    std::size_t row = 0, col = 0, first = 0;
+    if (upper == plain.size()) {
+        // только прописные буквы: полные строки переставляются ядрами transpose
+        row = transpose::permuteRows<false>(plain.data(), starts.data(), width, n / width, &out[0]);
+        first = row * width;
+    }
+    for (std::size_t i = first; i < plain.size(); ++i) {
+        int idx = rus::letterIndex(plain[i]);
+        if (idx < 0)
+            continue;
+        out[starts[col] + row] = rus::UPPER[idx];
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
+
+/** @brief Расшифровка: буква открытого текста из строки r и столбца c берётся из позиции starts[c] + r;
+ * полные строки собираются ядрами transpose */
+template <class String>
+CipherResult<String> Table::decryptTo(std::wstring_view cipher, const typename String::allocator_type& alloc) const
+{
+    if (cipher.empty())
+        return CipherError{CipherErrc::EmptyCipherText, 0};
+    const std::size_t bad = rus::firstNonUpper(cipher);
+    if (bad != cipher.size())
+        return CipherError{CipherErrc::InvalidCipherText, bad};
+
+    const std::size_t n = cipher.size();
+    Positions<String> starts(alloc);
+    columnStarts(n, cols, starts);
+    const std::size_t width = starts.size();
+
+    String out(n, L'\0', alloc);
+    std::size_t row = transpose::permuteRows<true>(cipher.data(), starts.data(), width, n / width, &out[0]);
+    std::size_t col = 0;
+    for (std::size_t i = row * width; i < n; ++i) {
+        out[i] = cipher[starts[col] + row];
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
+
+template <bool Decrypt>
+void Table::permuteInPlace(std::wstring& text) const
+{
+    const std::size_t width = std::min(static_cast<std::size_t>(cols), text.size());
+    if (width <= IN_PLACE_BUFFER / 16) {
+        wchar_t buf[IN_PLACE_BUFFER];
+        std::size_t starts[IN_PLACE_BUFFER / 16];
+        permuteTiles<Decrypt>(text, width, IN_PLACE_BUFFER / width, buf, starts);
+    } else {
+        std::vector<wchar_t> buf(std::min(16 * width, text.size()));
+        std::vector<std::size_t> starts(width);
+        permuteTiles<Decrypt>(text, width, 16, buf.data(), starts.data());
+    }
+}
+
+/** @brief Зашифровывание: плитки, затем перенос блоков, затем раскладка по группам столбцов;
+ * расшифровывание — те же шаги в обратном порядке. Столбец c шифротекста — группа j = width - 1 - c. */
+template <bool Decrypt>
+void Table::permuteTiles(std::wstring& text, std::size_t width, std::size_t height,
+                         wchar_t* buf, std::size_t* starts) const
+{
+    const std::size_t n = text.size();
+    const std::size_t rows = n / width;                 // полные строки
+    const std::size_t tail = n % width;                 // буквы неполной строки
+    const std::size_t tiles = rows / height;
+    const std::size_t block = tiles * height;           // букв столбца в плитках
+    const std::size_t rest = rows - block;              // полные строки после плиток
+    wchar_t* a = &text[0];
+    for (std::size_t c = 0; c < width; ++c)
+        starts[c] = (width - 1 - c) * height;
+
+    // начало группы j, если в каждом столбце len букв полных строк и ещё по одной у столбцов c < tail
+    auto groupStart = [&](std::size_t j, std::size_t len) {
+        return j * len + (tail + j > width ? tail + j - width : 0);
+    };
+    auto restLength = [&](std::size_t j) {
+        return rest + (tail + j >= width ? 1 : 0);
+    };
+    auto tile = [&](wchar_t* t) {
+        std::size_t r = transpose::permuteRows<Decrypt>(t, starts, width, height, buf);
+        for (; r < height; ++r) {
+            for (std::size_t c = 0; c < width; ++c) {
+                if (Decrypt)
+                    buf[r * width + c] = t[starts[c] + r];
+                else
+                    buf[starts[c] + r] = t[r * width + c];
+            }
+        }
+        std::copy(buf, buf + height * width, t);
+    };
+    // блок k получает блок from(k); цикл обходится от наименьшего номера блока
+    auto moveBlocks = [&](auto from) {
+        const std::size_t count = tiles * width;
+        for (std::size_t s = 0; s < count; ++s) {
+            std::size_t j = from(s);
+            if (j == s)
+                continue;
+            while (j > s)
+                j = from(j);
+            if (j != s)
+                continue;
+            std::copy(a + s * height, a + (s + 1) * height, buf);
+            std::size_t i = s;
+            for (j = from(s); j != s; j = from(j)) {
+                std::copy(a + j * height, a + (j + 1) * height, a + i * height);
+                i = j;
+            }
+            std::copy(buf, buf + height, a + i * height);
+        }
+    };
+
+    if (!Decrypt) {
+        for (std::size_t t = 0; t < tiles; ++t)
+            tile(a + t * height * width);
+        moveBlocks([&](std::size_t k) { return k % tiles * width + k / tiles; });
+        for (std::size_t p = block * width; p < n; ++p) {
+            std::size_t q = p - block * width;
+            buf[groupStart(width - 1 - q % width, rest) + q / width] = a[p];
+        }
+        for (std::size_t j = width; j-- > 0;) {
+            std::size_t dst = groupStart(j, rows);
+            std::copy_backward(a + j * block, a + (j + 1) * block, a + dst + block);
+            std::size_t from = groupStart(j, rest);
+            std::copy(buf + from, buf + from + restLength(j), a + dst + block);
+        }
+    } else {
+        for (std::size_t j = 0; j < width; ++j) {
+            std::size_t src = groupStart(j, rows);
+            std::copy(a + src + block, a + src + block + restLength(j), buf + groupStart(j, rest));
+            std::copy(a + src, a + src + block, a + j * block);
+        }
+        for (std::size_t p = block * width; p < n; ++p) {
+            std::size_t q = p - block * width;
+            a[p] = buf[groupStart(width - 1 - q % width, rest) + q / width];
+        }
+        moveBlocks([&](std::size_t k) { return k % width * tiles + k / width; });
+        for (std::size_t t = 0; t < tiles; ++t)
+            tile(a + t * height * width);
+    }
+}
+
+inline void Table::encryptInPlace(std::wstring& text) const
+{
+    std::size_t n = 0;
+    for (auto c : text) {
+        if (rus::letterIndex(c) >= 0)
+            n++;
+    }
+    if (n == 0)
+        throw cipher_error("Пустой открытый текст");
+    std::size_t k = 0;
+    for (auto c : text) {
+        int idx = rus::letterIndex(c);
+        if (idx >= 0)
+            text[k++] = rus::UPPER[idx];
+    }
+    text.resize(n);
+    permuteInPlace<false>(text);
+}
+
+inline void Table::decryptInPlace(std::wstring& text) const
+{
+    if (text.empty())
+        throw cipher_error("Пустой шифротекст");
+    if (rus::firstNonUpper(text) != text.size())
+        throw cipher_error("Недопустимый шифротекст");
+    permuteInPlace<true>(text);
+}
+
+/** @brief Строка и столбец переходят к следующей позиции без деления; начало столбца — по формуле cipherPos */
+inline std::wstring Table::decryptRange(std::wstring_view cipher, std::size_t offset, std::size_t count) const
+{
+    const std::size_t n = cipher.size();
+    if (n == 0)
+        throw cipher_error("Пустой шифротекст");
+    if (offset > n || count > n - offset)
+        throw cipher_error("Диапазон вне шифротекста");
+
+    const std::size_t width = std::min<std::size_t>(cols, n);
+    const std::size_t rows = (n + width - 1) / width;
+    const std::size_t fullCols = n % width == 0 ? width : n % width;
+    auto start = [&](std::size_t c) {
+        return (width - 1 - c) * (rows - 1) + (fullCols > c + 1 ? fullCols - c - 1 : 0);
+    };
+
+    std::wstring out(count, L'\0');
+    std::size_t row = offset / width, col = offset % width;
+    std::size_t colStart = start(col);
+    for (std::size_t i = 0; i < count; ++i) {
+        wchar_t c = cipher[colStart + row];
+        if (rus::upperIndex(c) < 0)
+            throw cipher_error("Недопустимый шифротекст");
+        out[i] = c;
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+        colStart = start(col);
+    }
+    return out;
+}
+
+/** @brief Буква из строки r и столбца c записывается двумя байтами в позицию 2 * (starts[c] + r) */
+inline std::string Table::encryptUtf8(std::string_view plain) const
+{
+    std::size_t n = 0, step = 1;
+    for (std::size_t i = 0; i < plain.size(); i += step) {
+        if (rus::utf8LetterAt(plain, i, step) >= 0)
+            n++;
+    }
+    if (n == 0)
+        throw cipher_error("Пустой открытый текст");
+
+    std::vector<std::size_t> starts;
+    columnStarts(n, cols, starts);
+    const std::size_t width = starts.size();
+
+    std::string out(2 * n, '\0');
+    std::size_t row = 0, col = 0;
+    for (std::size_t i = 0; i < plain.size(); i += step) {
+        int idx = rus::utf8LetterAt(plain, i, step);
+        if (idx < 0)
+            continue;
+        char* dst = &out[2 * (starts[col] + row)];
+        dst[0] = rus::utf8Lead(idx);
+        dst[1] = rus::utf8Trail(idx);
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
+
+/** @brief Двухбайтовые единицы собираются по строкам таблицы */
+inline std::string Table::decryptUtf8(std::string_view cipher) const
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+    if (cipher.size() % 2 != 0)
+        throw cipher_error("Недопустимый шифротекст");
+    for (std::size_t i = 0; i < cipher.size(); i += 2) {
+        if (rus::utf8UpperIndex(cipher[i], cipher[i + 1]) < 0)
+            throw cipher_error("Недопустимый шифротекст");
+    }
+
+    const std::size_t n = cipher.size() / 2;
+    std::vector<std::size_t> starts;
+    columnStarts(n, cols, starts);
+    const std::size_t width = starts.size();
+
+    std::string out(2 * n, '\0');
+    std::size_t row = 0, col = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::memcpy(&out[2 * i], &cipher[2 * (starts[col] + row)], 2);
+        if (++col == width) {
+            col = 0;
+            row++;
+        }
+    }
+    return out;
+}
+
+inline std::wstring Table::encrypt(const std::wstring& plain) const
+{
+    return encryptTo<std::wstring>(plain, {}).value();
+}
+
+inline std::wstring Table::decrypt(const std::wstring& cipher) const
+{
+    return decryptTo<std::wstring>(cipher, {}).value();
+}
+
+inline CipherResult<std::wstring> Table::tryEncrypt(std::wstring_view plain) const
+{
+    return encryptTo<std::wstring>(plain, {});
+}
+
+inline CipherResult<std::wstring> Table::tryDecrypt(std::wstring_view cipher) const
+{
+    return decryptTo<std::wstring>(cipher, {});
+}
+
+inline std::pmr::wstring Table::encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const
+{
+    return encryptTo<std::pmr::wstring>(plain, mr).value();
+}
+
+inline std::pmr::wstring Table::decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const
+{
+    return decryptTo<std::pmr::wstring>(cipher, mr).value();
+}
+
+/** @brief Столбцы считываются справа налево; левые n % cols столбцов на строку выше остальных */
+template <class Alloc>
+void Table::columnStarts(std::size_t n, std::size_t cols, std::vector<std::size_t, Alloc>& starts)
+{
+    std::size_t width = std::min(cols, n);
+    std::size_t rows = (n + width - 1) / width;
+    std::size_t fullCols = n % width;
+    if (fullCols == 0)
+        fullCols = width;
+
+    starts.resize(width);
+    std::size_t pos = 0;
+    for (std::size_t c = width; c-- > 0;) {
+        starts[c] = pos;
+        pos += (c < fullCols) ? rows : rows - 1;
+    }
+}
+
+inline std::vector<std::size_t> Table::columnStarts(std::size_t n, std::size_t cols)
+{
+    std::vector<std::size_t> starts;
+    columnStarts(n, cols, starts);
+    return starts;
+}
+
+/** @brief Столбец col начинается в шифротексте после всех столбцов правее него */
+inline std::size_t Table::cipherPos(std::size_t pos, std::size_t n, std::size_t cols)
+{
+    std::size_t rows = (n + cols - 1) / cols;
+    std::size_t fullCols = n % cols;
+    if (fullCols == 0)
+        fullCols = cols;
+
+    std::size_t r = pos / cols;
+    std::size_t c = pos % cols;
+    std::size_t start = (cols - 1 - c) * (rows - 1) + (fullCols > c + 1 ? fullCols - c - 1 : 0);
+    return start + r;
+}
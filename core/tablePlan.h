@@ -0,0 +1,113 @@
+/** @file tablePlan.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Цепочка табличных перестановок, сведённая к одной
+ * @details Библиотека только из заголовков. Несколько проходов Table с разным числом
+ * столбцов — композиция перестановок позиций, поэтому для известной длины текста
+ * она вычисляется заранее и применяется за один проход вместо прохода на каждый ключ.
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "cipher_error.h"
+#include "alphabet.h"
+#include "table.h"
+
+/** @brief Заранее вычисленная перестановка для цепочки ключей Table
+ * @details Результат encrypt совпадает с последовательным применением
+ * Table(keys[0]).encrypt, Table(keys[1]).encrypt и так далее; decrypt — обратная операция.
+ * План хранит для каждой позиции открытого текста её позицию в итоговом шифротексте
+ * и годится только для текстов из size() букв. Методы константные.
+ * @warning Реализация только для русского языка
+ */
+class TablePlan
+{
+private:
+    std::vector<std::size_t> target; ///< позиция в шифротексте для каждой позиции открытого текста
+
+public:
+    TablePlan() = delete; ///< запрет конструктора без параметров
+    /** @brief Построение плана
+     * @param keys Количество столбцов каждого прохода по порядку
+     * @param n Количество букв текста
+     * @throw cipher_error если цепочка пустая, ключ невалидный или n равно 0
+     */
+    TablePlan(const std::vector<int>& keys, std::size_t n);
+    /** @brief Зашифровывание
+     * @details Не-буквы пропускаются, строчные буквы приводятся к прописным
+     * и сразу записываются в итоговую позицию.
+     * @param plain Открытый текст из size() букв
+     * @return Зашифрованная строка
+     * @throw cipher_error если текст пустой после очистки или число букв не равно size()
+     */
+    std::wstring encrypt(const std::wstring& plain) const;
+    /** @brief Расшифровывание
+     * @param cipher Шифротекст из size() прописных букв
+     * @return Расшифрованная строка
+     * @throw cipher_error если шифротекст невалидный или его длина не равна size()
+     */
+    std::wstring decrypt(const std::wstring& cipher) const;
+    /** @brief Длина текста плана
+     * @return Количество букв
+     */
+    std::size_t size() const
+    {
+        return target.size();
+    }
+};
+
+/** @brief Позиции проводятся через все проходы: после прохода с cols столбцами позиция p переходит в Table::cipherPos(p) */
+inline TablePlan::TablePlan(const std::vector<int>& keys, std::size_t n)
+{
+    if (keys.empty())
+        throw cipher_error("Пустая цепочка перестановок");
+    for (int key : keys)
+        static_cast<void>(Table(key)); // бросает cipher_error для невалидного ключа
+    if (n == 0)
+        throw cipher_error("Пустой открытый текст");
+
+    target.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        target[i] = i;
+    for (int key : keys) {
+        for (auto& p : target)
+            p = Table::cipherPos(p, n, key);
+    }
+}
+
+inline std::wstring TablePlan::encrypt(const std::wstring& plain) const
+{
+    std::wstring out(target.size(), L'\0');
+    std::size_t k = 0;
+    for (auto c : plain) {
+        int idx = rus::letterIndex(c);
+        if (idx < 0)
+            continue;
+        if (k == target.size())
+            throw cipher_error("Длина текста не совпадает с планом");
+        out[target[k++]] = rus::UPPER[idx];
+    }
+    if (k == 0)
+        throw cipher_error("Пустой открытый текст");
+    if (k != target.size())
+        throw cipher_error("Длина текста не совпадает с планом");
+    return out;
+}
+
+inline std::wstring TablePlan::decrypt(const std::wstring& cipher) const
+{
+    if (cipher.empty())
+        throw cipher_error("Пустой шифротекст");
+    if (cipher.size() != target.size())
+        throw cipher_error("Длина текста не совпадает с планом");
+    for (auto c : cipher) {
+        if (rus::upperIndex(c) < 0)
+            throw cipher_error("Недопустимый шифротекст");
+    }
+    std::wstring out(target.size(), L'\0');
+    for (std::size_t i = 0; i < target.size(); ++i)
+        out[i] = cipher[target[i]];
+    return out;
+}
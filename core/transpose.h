@@ -0,0 +1,224 @@
+/** @file transpose.h
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Ядра транспонирования таблицы для малого числа столбцов
+ * @details Библиотека только из заголовков. Для 2, 4, 8 и 16 столбцов полные строки таблицы
+ * маршрутной перестановки переставляются блоками по 8 строк транспонированием
+ * в регистрах AVX2 (unpack/permute), для остальных ширин до 16 — скалярным циклом,
+ * развёрнутым по числу столбцов. Более широкие таблицы и оставшиеся строки
+ * обрабатывает общий цикл Table.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define TRANSPOSE_AVX2 1
+#endif
+
+/** @brief Перестановка полных строк таблицы
+ * @details Строка r, столбец c таблицы — позиция r * width + c открытого текста
+ * и позиция starts[c] + r шифротекста (Table::columnStarts).
+ */
+namespace transpose {
+
+/** @brief Развёрнутый по Width скалярный цикл
+ * @tparam Width Количество столбцов
+ * @tparam Gather true — сбор строк из столбцов (расшифровывание), false — разнесение (зашифровывание)
+ * @param src Исходный текст
+ * @param starts Начала столбцов в шифротексте
+ * @param rows Количество полных строк
+ * @param dst Результат
+ * @return Количество обработанных строк — все rows
+ */
+template <std::size_t Width, bool Gather>
+std::size_t rowsScalar(const wchar_t* src, const std::size_t* starts, std::size_t rows, wchar_t* dst)
+{
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < Width; ++c) {
+            if (Gather)
+                dst[r * Width + c] = src[starts[c] + r];
+            else
+                dst[starts[c] + r] = src[r * Width + c];
+        }
+    }
+    return rows;
+}
+
+#ifdef TRANSPOSE_AVX2
+/** @brief Транспонирование 8x8 32-битных элементов в регистрах */
+__attribute__((target("avx2")))
+inline void transpose8(__m256i v[8])
+{
+    __m256i t[8], u[8];
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(v[i], v[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(v[i], v[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        v[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        v[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+/** @brief Загрузка 8 символов */
+__attribute__((target("avx2")))
+inline __m256i load8(const wchar_t* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+/** @brief Запись 8 символов */
+__attribute__((target("avx2")))
+inline void store8(wchar_t* p, __m256i v)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+/** @brief Сбор строк из столбцов блоками по 8 строк в регистрах
+ * @tparam Width 2, 4, 8 или 16
+ * @return Количество обработанных строк, кратное 8
+ */
+template <std::size_t Width>
+__attribute__((target("avx2")))
+std::size_t gatherAvx2(const wchar_t* src, const std::size_t* starts, std::size_t rows, wchar_t* dst)
+{
+    const std::size_t blocks = rows / 8 * 8;
+    for (std::size_t r = 0; r < blocks; r += 8) {
+        wchar_t* out = dst + r * Width;
+        if (Width == 2) {
+            __m256i t0 = _mm256_unpacklo_epi32(load8(src + starts[0] + r), load8(src + starts[1] + r));
+            __m256i t1 = _mm256_unpackhi_epi32(load8(src + starts[0] + r), load8(src + starts[1] + r));
+            store8(out, _mm256_permute2x128_si256(t0, t1, 0x20));
+            store8(out + 8, _mm256_permute2x128_si256(t0, t1, 0x31));
+        } else if (Width == 4) {
+            __m256i v[4];
+            for (int c = 0; c < 4; ++c)
+                v[c] = load8(src + starts[c] + r);
+            __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+            __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+            __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+            __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+            __m256i u0 = _mm256_unpacklo_epi64(t0, t2); // строки 0 и 4
+            __m256i u1 = _mm256_unpackhi_epi64(t0, t2); // строки 1 и 5
+            __m256i u2 = _mm256_unpacklo_epi64(t1, t3); // строки 2 и 6
+            __m256i u3 = _mm256_unpackhi_epi64(t1, t3); // строки 3 и 7
+            store8(out, _mm256_permute2x128_si256(u0, u1, 0x20));
+            store8(out + 8, _mm256_permute2x128_si256(u2, u3, 0x20));
+            store8(out + 16, _mm256_permute2x128_si256(u0, u1, 0x31));
+            store8(out + 24, _mm256_permute2x128_si256(u2, u3, 0x31));
+        } else {
+            for (std::size_t half = 0; half < Width; half += 8) {
+                __m256i v[8];
+                for (int c = 0; c < 8; ++c)
+                    v[c] = load8(src + starts[half + c] + r);
+                transpose8(v);
+                for (int k = 0; k < 8; ++k)
+                    store8(out + k * Width + half, v[k]);
+            }
+        }
+    }
+    return blocks;
+}
+
+/** @brief Разнесение строк по столбцам блоками по 8 строк в регистрах
+ * @tparam Width 2, 4, 8 или 16
+ * @return Количество обработанных строк, кратное 8
+ */
+template <std::size_t Width>
+__attribute__((target("avx2")))
+std::size_t scatterAvx2(const wchar_t* src, const std::size_t* starts, std::size_t rows, wchar_t* dst)
+{
+    const std::size_t blocks = rows / 8 * 8;
+    for (std::size_t r = 0; r < blocks; r += 8) {
+        const wchar_t* in = src + r * Width;
+        if (Width == 2) {
+            const __m256i evenOdd = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            __m256i p0 = _mm256_permutevar8x32_epi32(load8(in), evenOdd);
+            __m256i p1 = _mm256_permutevar8x32_epi32(load8(in + 8), evenOdd);
+            store8(dst + starts[0] + r, _mm256_permute2x128_si256(p0, p1, 0x20));
+            store8(dst + starts[1] + r, _mm256_permute2x128_si256(p0, p1, 0x31));
+        } else if (Width == 4) {
+            __m256i x0 = load8(in), x1 = load8(in + 8), x2 = load8(in + 16), x3 = load8(in + 24);
+            __m256i u0 = _mm256_permute2x128_si256(x0, x2, 0x20); // строки 0 и 4
+            __m256i u1 = _mm256_permute2x128_si256(x0, x2, 0x31); // строки 1 и 5
+            __m256i u2 = _mm256_permute2x128_si256(x1, x3, 0x20); // строки 2 и 6
+            __m256i u3 = _mm256_permute2x128_si256(x1, x3, 0x31); // строки 3 и 7
+            __m256i t0 = _mm256_unpacklo_epi32(u0, u1);
+            __m256i t1 = _mm256_unpackhi_epi32(u0, u1);
+            __m256i t2 = _mm256_unpacklo_epi32(u2, u3);
+            __m256i t3 = _mm256_unpackhi_epi32(u2, u3);
+            store8(dst + starts[0] + r, _mm256_unpacklo_epi64(t0, t2));
+            store8(dst + starts[1] + r, _mm256_unpackhi_epi64(t0, t2));
+            store8(dst + starts[2] + r, _mm256_unpacklo_epi64(t1, t3));
+            store8(dst + starts[3] + r, _mm256_unpackhi_epi64(t1, t3));
+        } else {
+            for (std::size_t half = 0; half < Width; half += 8) {
+                __m256i v[8];
+                for (int k = 0; k < 8; ++k)
+                    v[k] = load8(in + k * Width + half);
+                transpose8(v);
+                for (int c = 0; c < 8; ++c)
+                    store8(dst + starts[half + c] + r, v[c]);
+            }
+        }
+    }
+    return blocks;
+}
+#endif
+
+/** @brief Выбор ядра по числу столбцов
+ * @tparam Gather true — сбор (расшифровывание), false — разнесение (зашифровывание)
+ * @param src Исходный текст
+ * @param starts Начала столбцов в шифротексте
+ * @param width Количество столбцов
+ * @param rows Количество полных строк таблицы
+ * @param dst Результат
+ * @return Количество обработанных строк (для ядер AVX2 — кратно 8); 0, если ширина больше 16
+ */
+template <bool Gather>
+std::size_t permuteRows(const wchar_t* src, const std::size_t* starts, std::size_t width, std::size_t rows, wchar_t* dst)
+{
+#ifdef TRANSPOSE_AVX2
+    static const bool hasAvx2 = sizeof(wchar_t) == 4 && __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        switch (width) {
+        case 2:
+            return Gather ? gatherAvx2<2>(src, starts, rows, dst) : scatterAvx2<2>(src, starts, rows, dst);
+        case 4:
+            return Gather ? gatherAvx2<4>(src, starts, rows, dst) : scatterAvx2<4>(src, starts, rows, dst);
+        case 8:
+            return Gather ? gatherAvx2<8>(src, starts, rows, dst) : scatterAvx2<8>(src, starts, rows, dst);
+        case 16:
+            return Gather ? gatherAvx2<16>(src, starts, rows, dst) : scatterAvx2<16>(src, starts, rows, dst);
+        }
+    }
+#endif
+    switch (width) {
+    case 2: return rowsScalar<2, Gather>(src, starts, rows, dst);
+    case 3: return rowsScalar<3, Gather>(src, starts, rows, dst);
+    case 4: return rowsScalar<4, Gather>(src, starts, rows, dst);
+    case 5: return rowsScalar<5, Gather>(src, starts, rows, dst);
+    case 6: return rowsScalar<6, Gather>(src, starts, rows, dst);
+    case 7: return rowsScalar<7, Gather>(src, starts, rows, dst);
+    case 8: return rowsScalar<8, Gather>(src, starts, rows, dst);
+    case 9: return rowsScalar<9, Gather>(src, starts, rows, dst);
+    case 10: return rowsScalar<10, Gather>(src, starts, rows, dst);
+    case 11: return rowsScalar<11, Gather>(src, starts, rows, dst);
+    case 12: return rowsScalar<12, Gather>(src, starts, rows, dst);
+    case 13: return rowsScalar<13, Gather>(src, starts, rows, dst);
+    case 14: return rowsScalar<14, Gather>(src, starts, rows, dst);
+    case 15: return rowsScalar<15, Gather>(src, starts, rows, dst);
+    case 16: return rowsScalar<16, Gather>(src, starts, rows, dst);
+    default: return 0;
+    }
+}
+
+} // namespace transpose
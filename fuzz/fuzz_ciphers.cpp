@@ -0,0 +1,513 @@
+/** @file fuzz_ciphers.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Дифференциальный фаззинг шифров
+ * @details Каждый случай декодируется из массива байт: операция, число столбцов (два байта:
+ * в половине случаев — любое 16-битное значение, иначе — 8-битное), ключ и текст
+ * из символов, среди которых прописные и строчные русские буквы (включая Ё/ё), пробелы,
+ * знаки препинания, цифры, латиница и соседние с кириллицей коды.
+ * Отдельная операция повторяет текст до десятков тысяч букв, чтобы Table на месте
+ * проходил и перестановку плитками, и обход циклов для широких таблиц.
+ * Результат (строка или текст ошибки cipher_error) каждой реализации сравнивается
+ * с эталоном из reference.h; шифры проверяются и с памятью по умолчанию, и с монотонным
+ * ресурсом памяти. При расхождении случай печатается и программа аварийно завершается.
+ *
+ * Сборка с -DFUZZ_LIBFUZZER даёт цель libFuzzer (LLVMFuzzerTestOneInput),
+ * без неё — самостоятельную программу со случайной генерацией входов.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <memory_resource>
+#include "reference.h"
+#include "modAlphaCipher.h"
+#include "table.h"
+#include "compositeCipher.h"
+#include "fixedCipher.h"
+#include "tablePlan.h"
+
+using namespace std;
+
+namespace {
+
+/** @brief Результат вызова шифра: строка или сообщение об ошибке */
+struct Outcome {
+    bool ok;         ///< вызов завершился без исключения
+    wstring text;    ///< результат при ok
+    string error;    ///< текст ошибки при !ok
+    bool operator==(const Outcome& o) const
+    {
+        return ok == o.ok && text == o.text && error == o.error;
+    }
+};
+
+/** @brief Вызов эталонной реализации */
+template <class F>
+Outcome runRef(F&& fn)
+{
+    try {
+        return Outcome{true, fn(), ""};
+    } catch (const ref::cipher_error& e) {
+        return Outcome{false, L"", e.what()};
+    }
+}
+
+/** @brief Вызов проверяемой реализации */
+template <class F>
+Outcome runOpt(F&& fn)
+{
+    try {
+        return Outcome{true, fn(), ""};
+    } catch (const cipher_error& e) {
+        return Outcome{false, L"", e.what()};
+    }
+}
+
+/** @brief Результат вызова без исключений в виде Outcome
+ * @details Для InvalidCipherText позиция должна указывать на первый недопустимый символ input,
+ * иначе сообщение заменяется, и случай расходится с эталоном.
+ */
+template <class F>
+Outcome runTry(const wstring& input, F&& fn)
+{
+    try {
+        auto r = fn();
+        if (r)
+            return Outcome{true, wstring(r.value()), ""};
+        const CipherError& e = r.error();
+        if (e.code == CipherErrc::InvalidCipherText) {
+            bool first = e.position < input.size() && rus::upperIndex(input[e.position]) < 0;
+            for (size_t i = 0; first && i < e.position; ++i)
+                first = rus::upperIndex(input[i]) >= 0;
+            if (!first)
+                return Outcome{false, L"", "неверная позиция ошибки"};
+        }
+        return Outcome{false, L"", e.message()};
+    } catch (const cipher_error& e) {
+        return Outcome{false, L"", e.what()};
+    }
+}
+
+/** @brief Кодирование в UTF-8 (суррогаты и символы вне Unicode не встречаются в PALETTE) */
+string toUtf8(const wstring& ws)
+{
+    string out;
+    for (wchar_t wc : ws) {
+        uint32_t c = static_cast<uint32_t>(wc);
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | c >> 6));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xE0 | c >> 12));
+            out.push_back(static_cast<char>(0x80 | (c >> 6 & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    return out;
+}
+
+/** @brief Байты строки как символы, чтобы сравнивать результаты в UTF-8 через Outcome */
+wstring bytes(const string& s)
+{
+    wstring out;
+    for (unsigned char b : s)
+        out.push_back(b);
+    return out;
+}
+
+/** @brief Символы, из которых собираются ключ и текст */
+const wstring PALETTE = wstring(L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ")
+    + L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя"
+    + L" ,.!-19AzЂѐЀѠ\x3ff\x4ff" + wstring(1, L'\0');
+
+/** @brief Чтение байт случая по порядку; за концом данных возвращаются нули */
+class Reader
+{
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+
+public:
+    Reader(const uint8_t* d, size_t s): data(d), size(s) {}
+    uint8_t byte()
+    {
+        return pos < size ? data[pos++] : 0;
+    }
+    bool empty() const
+    {
+        return pos >= size;
+    }
+    wstring text(size_t len)
+    {
+        wstring s;
+        for (size_t i = 0; i < len && !empty(); ++i) {
+            uint8_t b = byte();
+            // две трети символов — прописные буквы, чтобы чаще получался валидный шифротекст
+            s.push_back(b < 170 ? PALETTE[b % 33] : PALETTE[b % PALETTE.size()]);
+        }
+        return s;
+    }
+};
+
+void report(const char* what, const wstring& key, int cols, const wstring& text,
+            const Outcome& expected, const Outcome& actual)
+{
+    cerr << "РАСХОЖДЕНИЕ: " << what << "\n  cols = " << cols << "\n  key =";
+    for (auto c : key)
+        cerr << ' ' << static_cast<long>(c);
+    cerr << "\n  text =";
+    for (auto c : text)
+        cerr << ' ' << static_cast<long>(c);
+    cerr << "\n  эталон: " << (expected.ok ? "ok" : expected.error)
+         << "\n  проверяемая: " << (actual.ok ? "ok" : actual.error) << endl;
+    abort();
+}
+
+void expectSame(const char* what, const wstring& key, int cols, const wstring& text,
+                const Outcome& expected, const Outcome& actual)
+{
+    if (!(expected == actual))
+        report(what, key, cols, text, expected, actual);
+}
+
+/** @brief Позиции Table::cipherPos и Table::columnStarts, а также Table на тексте
+ * из одних прописных букв (путь ядер transpose) против эталонного шифрования */
+void checkPositions(int cols, const wstring& text)
+{
+    if (cols <= 1 || text.empty())
+        return;
+    wstring plain;
+    for (auto c : text) {
+        if (rus::upperIndex(c) >= 0)
+            plain.push_back(c);
+    }
+    if (plain.empty())
+        return;
+    wstring cipher = ref::Table(cols).encrypt(plain);
+    expectSame("Table::encrypt (прописные)", L"", cols, plain, Outcome{true, cipher, ""},
+               runOpt([&] { return Table(cols).encrypt(plain); }));
+    expectSame("Table::decrypt (прописные)", L"", cols, cipher, Outcome{true, plain, ""},
+               runOpt([&] { return Table(cols).decrypt(cipher); }));
+    vector<size_t> starts = Table::columnStarts(plain.size(), cols);
+    for (size_t i = 0; i < plain.size(); ++i) {
+        size_t pos = Table::cipherPos(i, plain.size(), cols);
+        size_t fromStarts = starts[i % starts.size()] + i / starts.size();
+        if (pos >= cipher.size() || cipher[pos] != plain[i] || fromStarts != pos)
+            report("Table::cipherPos", L"", cols, plain, Outcome{true, L"", ""}, Outcome{false, L"", "позиция"});
+    }
+    const vector<int> chain = {cols, cols / 2 + 2, 3};
+    wstring chained = plain;
+    for (int key : chain)
+        chained = ref::Table(key).encrypt(chained);
+    expectSame("TablePlan::encrypt", L"", cols, plain, Outcome{true, chained, ""},
+               runOpt([&] { return TablePlan(chain, plain.size()).encrypt(plain); }));
+    expectSame("TablePlan::decrypt", L"", cols, chained, Outcome{true, plain, ""},
+               runOpt([&] { return TablePlan(chain, plain.size()).decrypt(chained); }));
+    size_t offset = cipher.size() * 2 / 5, count = (cipher.size() - offset + 1) / 2;
+    expectSame("Table::decryptRange", L"", cols, cipher, Outcome{true, plain.substr(offset, count), ""},
+               runOpt([&] { return Table(cols).decryptRange(cipher, offset, count); }));
+}
+
+/** @brief Table на длинном тексте: text повторяется до len символов
+ * @details Не меньше IN_PLACE_BUFFER букв нужно, чтобы encryptInPlace и decryptInPlace
+ * собирали полные плитки; при cols > 128 плитки по 16 строк идут через буфер в куче.
+ */
+void checkLong(int cols, const wstring& text, size_t len)
+{
+    if (text.empty())
+        return;
+    wstring plain;
+    plain.reserve(len + text.size());
+    while (plain.size() < len)
+        plain += text;
+    Outcome expected = runRef([&] { return ref::Table(cols).encrypt(plain); });
+    expectSame("Table::encrypt (длинный)", L"", cols, plain, expected,
+               runOpt([&] { return Table(cols).encrypt(plain); }));
+    expectSame("Table::encryptInPlace (длинный)", L"", cols, plain, expected, runOpt([&] {
+                   wstring work = plain;
+                   Table(cols).encryptInPlace(work);
+                   return work;
+               }));
+    if (!expected.ok)
+        return;
+    const wstring cipher = expected.text;
+    expected = runRef([&] { return ref::Table(cols).decrypt(cipher); });
+    expectSame("Table::decrypt (длинный)", L"", cols, cipher, expected,
+               runOpt([&] { return Table(cols).decrypt(cipher); }));
+    expectSame("Table::decryptInPlace (длинный)", L"", cols, cipher, expected, runOpt([&] {
+                   wstring work = cipher;
+                   Table(cols).decryptInPlace(work);
+                   return work;
+               }));
+}
+
+/** @brief Шаблонные шифры с фиксированным ключом против эталона с тем же ключом */
+void checkFixed(int cols, const wstring& text)
+{
+    using Gronsfeld = FixedGronsfeld<L'Г', L'р', L'О', L'М'>;
+    expectSame("FixedGronsfeld::encrypt", L"ГРОМ", cols, text,
+               runRef([&] { return ref::modAlphaCipher(L"ГРОМ").encrypt(text); }),
+               runOpt([&] { return Gronsfeld::encrypt(text); }));
+    expectSame("FixedGronsfeld::decrypt", L"ГРОМ", cols, text,
+               runRef([&] { return ref::modAlphaCipher(L"ГРОМ").decrypt(text); }),
+               runOpt([&] { return Gronsfeld::decrypt(text); }));
+
+    const int fixedCols[] = {2, 3, 5, 16};
+    const int c = fixedCols[static_cast<unsigned>(cols) % 4];
+    auto encrypt = [&]() -> wstring {
+        switch (c) {
+        case 2: return FixedTable<2>::encrypt(text);
+        case 3: return FixedTable<3>::encrypt(text);
+        case 5: return FixedTable<5>::encrypt(text);
+        default: return FixedTable<16>::encrypt(text);
+        }
+    };
+    auto decrypt = [&]() -> wstring {
+        switch (c) {
+        case 2: return FixedTable<2>::decrypt(text);
+        case 3: return FixedTable<3>::decrypt(text);
+        case 5: return FixedTable<5>::decrypt(text);
+        default: return FixedTable<16>::decrypt(text);
+        }
+    };
+    expectSame("FixedTable::encrypt", L"", c, text,
+               runRef([&] { return ref::Table(c).encrypt(text); }), runOpt(encrypt));
+    expectSame("FixedTable::decrypt", L"", c, text,
+               runRef([&] { return ref::Table(c).decrypt(text); }), runOpt(decrypt));
+}
+
+/** @brief Шифрование упакованного текста против эталона на распакованном */
+void checkPacked(const wstring& key, int cols, const wstring& text)
+{
+    Outcome expected = runRef([&] { return ref::modAlphaCipher(key).encrypt(text); });
+    if (expected.ok) {
+        expectSame("modAlphaCipher::encrypt(PackedText)", key, cols, text, expected, runOpt([&] {
+            wstring letters;
+            for (auto c : text) {
+                int idx = rus::letterIndex(c);
+                if (idx >= 0)
+                    letters.push_back(rus::UPPER[idx]);
+            }
+            return modAlphaCipher(key).encrypt(PackedText::fromText(letters)).toText();
+        }));
+    }
+    expected = runRef([&] { return ref::modAlphaCipher(key).decrypt(text); });
+    if (expected.ok) {
+        expectSame("modAlphaCipher::decrypt(PackedText)", key, cols, text, expected,
+                   runOpt([&] { return modAlphaCipher(key).decrypt(PackedText::fromText(text)).toText(); }));
+    }
+}
+
+} // namespace
+
+/** @brief Проверка одного случая
+ * @param data Байты случая
+ * @param size Количество байт
+ * @return 0
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    Reader in(data, size);
+    uint8_t op = in.byte();
+    uint8_t low = in.byte();
+    uint8_t high = in.byte();
+    int cols = high & 0x40 ? static_cast<int16_t>(low | high << 8) : static_cast<int8_t>(low);
+    size_t longLen = 2048 + (static_cast<size_t>(high) << 8 | low) % 40000;
+    wstring key = in.text(in.byte() % 8);
+    wstring text = in.text(size);
+    std::pmr::monotonic_buffer_resource arena;
+    Outcome expected;
+
+    switch (op % 10) {
+    case 0:
+        expected = runRef([&] { return ref::modAlphaCipher(key).encrypt(text); });
+        expectSame("modAlphaCipher::encrypt", key, cols, text, expected,
+                   runOpt([&] { return modAlphaCipher(key).encrypt(text); }));
+        expectSame("modAlphaCipher::encrypt(memory_resource)", key, cols, text, expected,
+                   runOpt([&] { return wstring(modAlphaCipher(key).encrypt(text, &arena)); }));
+        expectSame("modAlphaCipher::tryEncrypt", key, cols, text, expected,
+                   runTry(text, [&] {
+                       auto cp = modAlphaCipher::tryCreate(key);
+                       return cp ? cp.value().tryEncrypt(text) : CipherResult<wstring>(cp.error());
+                   }));
+        if (expected.ok) {
+            // буквы эталона в регистре исходных букв, остальные символы на своих местах
+            wstring layout = text;
+            size_t k = 0;
+            for (auto& c : layout) {
+                if (rus::letterIndex(c) < 0)
+                    continue;
+                int r = rus::upperIndex(expected.text[k++]);
+                c = rus::upperIndex(c) >= 0 ? rus::UPPER[r] : rus::LOWER[r];
+            }
+            expectSame("modAlphaCipher::encryptPreserving", key, cols, text, Outcome{true, bytes(toUtf8(layout)), ""},
+                       runOpt([&] { return bytes(modAlphaCipher(key).encryptPreserving(toUtf8(text))); }));
+            expectSame("modAlphaCipher::decryptPreserving", key, cols, layout, Outcome{true, bytes(toUtf8(text)), ""},
+                       runOpt([&] { return bytes(modAlphaCipher(key).decryptPreserving(toUtf8(layout))); }));
+        } else {
+            expectSame("modAlphaCipher::encryptPreserving", key, cols, text, expected,
+                       runOpt([&] { return bytes(modAlphaCipher(key).encryptPreserving(toUtf8(text))); }));
+        }
+        expectSame("modAlphaCipher::encryptMany", key, cols, text,
+                   runRef([&] {
+                       wstring first = ref::modAlphaCipher(key).encrypt(text);
+                       return first + L"|" + ref::modAlphaCipher(key + L"ВГ").encrypt(text);
+                   }),
+                   runOpt([&] {
+                       vector<wstring> out = modAlphaCipher::encryptMany({modAlphaCipher(key), modAlphaCipher(key + L"ВГ")}, text);
+                       return out[0] + L"|" + out[1];
+                   }));
+        break;
+    case 1:
+        expected = runRef([&] { return ref::modAlphaCipher(key).decrypt(text); });
+        expectSame("modAlphaCipher::decrypt", key, cols, text, expected,
+                   runOpt([&] { return modAlphaCipher(key).decrypt(text); }));
+        expectSame("modAlphaCipher::decrypt(memory_resource)", key, cols, text, expected,
+                   runOpt([&] { return wstring(modAlphaCipher(key).decrypt(text, &arena)); }));
+        expectSame("modAlphaCipher::tryDecrypt", key, cols, text, expected,
+                   runTry(text, [&] {
+                       auto cp = modAlphaCipher::tryCreate(key);
+                       return cp ? cp.value().tryDecrypt(text) : CipherResult<wstring>(cp.error());
+                   }));
+        if (!text.empty()) {
+            expectSame("modAlphaCipher::decryptView", key, cols, text, expected, runOpt([&] {
+                           modAlphaCipher cp(key);
+                           auto view = cp.decryptView(text);
+                           return wstring(view.begin(), view.end());
+                       }));
+        }
+        if (expected.ok) {
+            const wstring next = key + L"ВГ";
+            expectSame("modAlphaCipher::rekey", next, cols, text,
+                       runRef([&] { return ref::modAlphaCipher(next).encrypt(expected.text); }),
+                       runOpt([&] { return modAlphaCipher::rekey(modAlphaCipher(key), modAlphaCipher(next), text); }));
+            size_t offset = static_cast<unsigned>(cols) % text.size();
+            Outcome suffix{true, expected.text.substr(offset), ""};
+            expectSame("modAlphaCipher::decryptFragment", key, cols, text, suffix,
+                       runOpt([&] { return modAlphaCipher(key).decryptFragment(wstring_view(text).substr(offset), offset); }));
+        }
+        break;
+    case 2:
+        expected = runRef([&] { return ref::Table(cols).encrypt(text); });
+        expectSame("Table::encrypt", key, cols, text, expected,
+                   runOpt([&] { return Table(cols).encrypt(text); }));
+        expectSame("Table::encrypt(memory_resource)", key, cols, text, expected,
+                   runOpt([&] { return wstring(Table(cols).encrypt(text, &arena)); }));
+        expectSame("Table::tryEncrypt", key, cols, text, expected,
+                   runTry(text, [&] {
+                       auto cp = Table::tryCreate(cols);
+                       return cp ? cp.value().tryEncrypt(text) : CipherResult<wstring>(cp.error());
+                   }));
+        expectSame("Table::encryptInPlace", key, cols, text, expected, runOpt([&] {
+                       wstring work = text;
+                       Table(cols).encryptInPlace(work);
+                       return work;
+                   }));
+        expectSame("Table::encryptUtf8", key, cols, text,
+                   Outcome{expected.ok, bytes(toUtf8(expected.text)), expected.error},
+                   runOpt([&] { return bytes(Table(cols).encryptUtf8(toUtf8(text))); }));
+        break;
+    case 3:
+        expected = runRef([&] { return ref::Table(cols).decrypt(text); });
+        expectSame("Table::decrypt", key, cols, text, expected,
+                   runOpt([&] { return Table(cols).decrypt(text); }));
+        expectSame("Table::decrypt(memory_resource)", key, cols, text, expected,
+                   runOpt([&] { return wstring(Table(cols).decrypt(text, &arena)); }));
+        expectSame("Table::tryDecrypt", key, cols, text, expected,
+                   runTry(text, [&] {
+                       auto cp = Table::tryCreate(cols);
+                       return cp ? cp.value().tryDecrypt(text) : CipherResult<wstring>(cp.error());
+                   }));
+        expectSame("Table::decryptInPlace", key, cols, text, expected, runOpt([&] {
+                       wstring work = text;
+                       Table(cols).decryptInPlace(work);
+                       return work;
+                   }));
+        expectSame("Table::decryptUtf8", key, cols, text,
+                   Outcome{expected.ok, bytes(toUtf8(expected.text)), expected.error},
+                   runOpt([&] { return bytes(Table(cols).decryptUtf8(toUtf8(text))); }));
+        if (!text.empty()) {
+            expectSame("Table::decryptView", key, cols, text, expected, runOpt([&] {
+                           Table t(cols);
+                           auto view = t.decryptView(text);
+                           return wstring(view.begin(), view.end());
+                       }));
+        }
+        break;
+    case 4:
+        expectSame("CompositeCipher::encrypt", key, cols, text,
+                   runRef([&] {
+                       ref::modAlphaCipher sub(key);
+                       ref::Table perm(cols);
+                       return perm.encrypt(sub.encrypt(text));
+                   }),
+                   runOpt([&] { return CompositeCipher(key, cols).encrypt(text); }));
+        break;
+    case 5:
+        expectSame("CompositeCipher::decrypt", key, cols, text,
+                   runRef([&] {
+                       ref::modAlphaCipher sub(key);
+                       ref::Table perm(cols);
+                       return sub.decrypt(perm.decrypt(text));
+                   }),
+                   runOpt([&] { return CompositeCipher(key, cols).decrypt(text); }));
+        break;
+    case 6:
+        checkPositions(cols, text);
+        break;
+    case 7:
+        checkFixed(cols, text);
+        break;
+    case 8:
+        checkPacked(key, cols, text);
+        break;
+    case 9:
+        checkLong(cols, text, longLen);
+        break;
+    }
+    return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+/** @brief Самостоятельный режим: случайные случаи
+ * @param argc Число аргументов
+ * @param argv Необязательные аргументы: число случаев (по умолчанию 1000000) и начальное значение генератора
+ * @return 0, если расхождений не найдено
+ */
+int main(int argc, char* argv[])
+{
+    unsigned long long cases = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    uint64_t state = argc > 2 ? strtoull(argv[2], nullptr, 10) : 88172645463325252ULL;
+    if (state == 0)
+        state = 1;
+
+    vector<uint8_t> buf;
+    auto start = chrono::steady_clock::now();
+    for (unsigned long long n = 0; n < cases; ++n) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // каждый шестнадцатый случай длинный, чтобы таблицы набирали полные блоки строк
+        buf.resize(4 + (n % 16 == 0 ? state % 509 : state % 61));
+        for (auto& b : buf) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            b = static_cast<uint8_t>(state >> 32);
+        }
+        LLVMFuzzerTestOneInput(buf.data(), buf.size());
+    }
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << cases << " случаев без расхождений за " << sec << " с ("
+         << static_cast<long long>(cases / (sec > 0 ? sec : 1)) << " случаев/с)" << endl;
+    return 0;
+}
+#endif
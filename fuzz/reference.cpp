@@ -0,0 +1,238 @@
+/** @file reference.cpp
+ * @author Ладыгин П.А.
+ * @version 1.0
+ * @date 18.10.26
+ * @brief Эталонные реализации шифров (дословные копии из Lab4)
+ */
+#include "reference.h"
+#include <vector>
+using namespace std;
+
+namespace ref {
+
+modAlphaCipher::modAlphaCipher(const wstring& keyStr)
+{
+    for (unsigned k = 0; k < alphabet.size(); ++k) {
+        alphaIndex[alphabet[k]] = k;
+    }
+    keySeq = toNums(getValidKey(keyStr));
+}
+
+vector<int> modAlphaCipher::toNums(const wstring& s)
+{
+    vector<int> resultNums;
+    resultNums.reserve(s.size());
+    for (auto sym : s) {
+        resultNums.push_back(alphaIndex[sym]);
+    }
+    return resultNums;
+}
+
+wstring modAlphaCipher::toStr(const vector<int>& v)
+{
+    wstring resultStr;
+    resultStr.reserve(v.size());
+    for (auto idx : v) {
+        resultStr.push_back(alphabet[idx]);
+    }
+    return resultStr;
+}
+
+wstring modAlphaCipher::getValidKey(const wstring& s)
+{
+    if (s.empty())
+        throw cipher_error("Пустой ключ");
+
+    wstring lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+    wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    wstring tmp;
+
+    for (auto c : s) {
+        size_t pos = lower.find(c);
+        if (pos != wstring::npos) {
+            tmp.push_back(upper[pos]);
+        } else if (alphabet.find(c) != wstring::npos) {
+            tmp.push_back(c);
+        } else {
+            throw cipher_error("Недопустимый ключ");
+        }
+    }
+
+    int zeroCount = 0;
+    for (auto c : tmp) {
+        if (c == L'А')
+            zeroCount++;
+    }
+    if (2 * zeroCount > static_cast<int>(tmp.size()))
+        throw cipher_error("Вырожденный ключ");
+
+    return tmp;
+}
+
+wstring modAlphaCipher::getValidOpenText(const wstring& s)
+{
+    wstring tmp;
+    wstring lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+    wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+
+    for (auto c : s) {
+        if (alphabet.find(c) != wstring::npos) {
+            tmp.push_back(c);
+        } else {
+            size_t pos = lower.find(c);
+            if (pos != wstring::npos) {
+                tmp.push_back(upper[pos]);
+            }
+        }
+    }
+    if (tmp.empty())
+        throw cipher_error("Пустой открытый текст");
+    return tmp;
+}
+
+wstring modAlphaCipher::getValidCipherText(const wstring& s)
+{
+    if (s.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    for (auto c : s) {
+        if (alphabet.find(c) == wstring::npos)
+            throw cipher_error("Недопустимый шифротекст");
+    }
+    return s;
+}
+
+/** @brief Зашифровывание: к каждому символу прибавляется элемент ключа по модулю размера алфавита */
+wstring modAlphaCipher::encrypt(const wstring& plain)
+{
+    vector<int> tmp = toNums(getValidOpenText(plain));
+    for (unsigned p = 0; p < tmp.size(); ++p) {
+        tmp[p] = (tmp[p] + keySeq[p % keySeq.size()]) % alphabet.size();
+    }
+    return toStr(tmp);
+}
+
+/** @brief Расшифровывание: из каждого символа вычитается элемент ключа по модулю размера алфавита */
+wstring modAlphaCipher::decrypt(const wstring& cipher)
+{
+    vector<int> tmp = toNums(getValidCipherText(cipher));
+    for (unsigned p = 0; p < tmp.size(); ++p) {
+        tmp[p] = (tmp[p] + alphabet.size() - keySeq[p % keySeq.size()]) % alphabet.size();
+    }
+    return toStr(tmp);
+}
+
+/** @brief Валидация ключа: должен быть > 1 */
+int Table::getValidKey(int key)
+{
+    if (key <= 1)
+        throw cipher_error("Недопустимый ключ: должен быть > 1");
+    return key;
+}
+
+/** @brief Валидация открытого текста: приведение к верхнему регистру, удаление не-букв */
+wstring Table::getValidOpenText(const wstring& s)
+{
+    wstring tmp;
+    wstring lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+    wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+
+    for (auto c : s) {
+        if (upper.find(c) != wstring::npos) {
+            tmp.push_back(c);
+        } else {
+            size_t pos = lower.find(c);
+            if (pos != wstring::npos) {
+                tmp.push_back(upper[pos]);
+            }
+        }
+    }
+    if (tmp.empty())
+        throw cipher_error("Пустой открытый текст");
+    return tmp;
+}
+
+/** @brief Валидация шифротекста: только прописные русские буквы */
+wstring Table::getValidCipherText(const wstring& s)
+{
+    if (s.empty())
+        throw cipher_error("Пустой шифротекст");
+
+    wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    for (auto c : s) {
+        if (upper.find(c) == wstring::npos)
+            throw cipher_error("Недопустимый шифротекст");
+    }
+    return s;
+}
+
+Table::Table(int key)
+{
+    cols = getValidKey(key);
+}
+
+/** @brief Шифрование: запись по строкам, считывание по столбцам справа налево */
+wstring Table::encrypt(const wstring& plain)
+{
+    wstring validText = getValidOpenText(plain);
+    int n = static_cast<int>(validText.length());
+    int rows = (n + cols - 1) / cols;
+
+    vector<vector<wchar_t>> grid(rows, vector<wchar_t>(cols, L'\0'));
+    int pos = 0;
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (pos < n) {
+                grid[r][c] = validText[pos++];
+            }
+        }
+    }
+
+    wstring out;
+    out.reserve(n);
+    for (int c = cols - 1; c >= 0; --c) {
+        for (int r = 0; r < rows; ++r) {
+            if (grid[r][c] != L'\0') {
+                out += grid[r][c];
+            }
+        }
+    }
+    return out;
+}
+
+/** @brief Расшифровка: запись по столбцам справа налево, считывание по строкам */
+wstring Table::decrypt(const wstring& cipher)
+{
+    wstring validText = getValidCipherText(cipher);
+    int n = static_cast<int>(validText.length());
+    int rows = (n + cols - 1) / cols;
+
+    int fullCols = n % cols;
+    if (fullCols == 0) fullCols = cols;
+
+    vector<vector<wchar_t>> grid(rows, vector<wchar_t>(cols, L'\0'));
+    int pos = 0;
+
+    for (int c = cols - 1; c >= 0; --c) {
+        int h = (c < fullCols) ? rows : rows - 1;
+        for (int r = 0; r < h; ++r) {
+            if (pos < n) {
+                grid[r][c] = validText[pos++];
+            }
+        }
+    }
+
+    wstring out;
+    out.reserve(n);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (grid[r][c] != L'\0') {
+                out += grid[r][c];
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace ref
@@ -1,8 +1,11 @@
-/** @file modAlphaCipher.h
+/** @file reference.h
  * @author Ладыгин П.А.
  * @version 1.0
- * @date 17.12.25
- * @brief Заголовочный файл модуля шифрования методом Гронсфельда
+ * @date 18.10.26
+ * @brief Эталонные реализации шифров для дифференциального тестирования
+ * @details Дословные копии modAlphaCipher и Table из Lab4 (версия 1.0, 17.12.25)
+ * в пространстве имён ref. Не оптимизируются и не изменяются:
+ * любая оптимизированная реализация должна давать те же результаты и ошибки.
  */
 #pragma once
 #include <vector>
@@ -10,6 +13,9 @@
 #include <map>
 #include <stdexcept>
 
+/** @brief Эталонные реализации */
+namespace ref {
+
 /** @brief Класс исключений для ошибок шифрования
  * @details Наследуется от std::invalid_argument.
  * Используется для передачи информации об ошибках при работе с шифром.
@@ -88,3 +94,54 @@ public:
      */
     std::wstring decrypt(const std::wstring& cipher);
 };
+
+/** @brief Шифрование методом маршрутной перестановки (табличный шифр)
+ * @details Текст записывается в таблицу по строкам слева направо,
+ * а считывается по столбцам справа налево. Ключ — количество столбцов.
+ * @warning Реализация только для русского языка
+ */
+class Table
+{
+private:
+    int cols; ///< количество столбцов в таблице (ключ)
+    /** @brief Валидация ключа
+     * @param key Количество столбцов
+     * @return Валидный ключ
+     * @throws cipher_error если ключ <= 1
+     */
+    int getValidKey(int key);
+    /** @brief Валидация и нормализация открытого текста
+     * @param s Открытый текст
+     * @return Текст в верхнем регистре, только русские буквы
+     * @throws cipher_error если текст пустой после очистки
+     */
+    std::wstring getValidOpenText(const std::wstring& s);
+    /** @brief Валидация шифротекста
+     * @param s Шифротекст
+     * @return Валидный шифротекст
+     * @throws cipher_error если текст пустой или содержит недопустимые символы
+     */
+    std::wstring getValidCipherText(const std::wstring& s);
+
+public:
+    Table() = delete; ///< запрет конструктора без параметров
+    /** @brief Конструктор для установки ключа
+     * @param key Количество столбцов (ключ шифрования)
+     * @throws cipher_error если ключ невалидный
+     */
+    explicit Table(int key);
+    /** @brief Зашифровывание
+     * @param plain Открытый текст
+     * @return Зашифрованная строка
+     * @throws cipher_error если текст невалидный
+     */
+    std::wstring encrypt(const std::wstring& plain);
+    /** @brief Расшифровывание
+     * @param cipher Шифротекст
+     * @return Расшифрованная строка
+     * @throws cipher_error если шифротекст невалидный
+     */
+    std::wstring decrypt(const std::wstring& cipher);
+};
+
+} // namespace ref